@@ -1,7 +1,15 @@
 HEADERS += ../../src/templates/avl_tree.h \
 ../../src/templates/bsearch.h \
+../../src/templates/eytzinger.h \
+../../src/templates/simd_search.h \
+../../src/templates/interpolation_search.h \
 ../../src/templates/rb_tree.h \
 ../../src/templates/lexical_tree.h \
 ../../src/templates/fixed_alloc.h \
+../../src/templates/mt_fixed_alloc.h \
 ../../src/templates/stack.h \
-../../src/templates/vector.h
+../../src/templates/segmented_stack.h \
+../../src/templates/lf_stack.h \
+../../src/templates/vector.h \
+../../src/templates/mmap_vector.h \
+../../src/templates/bitops.h
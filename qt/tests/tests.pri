@@ -3,10 +3,24 @@ HEADERS += ../../src/tests/test_alloc_foreach.h \
 ../../src/tests/test_generic_tree.h
 
 SOURCES += ../../src/tests/main.c \
+../../src/tests/test_bitops.c \
 ../../src/tests/test_fixed_alloc.c \
+../../src/tests/test_mt_fixed_alloc.c \
 ../../src/tests/test_bsearch.c \
+../../src/tests/test_eytzinger.c \
+../../src/tests/test_simd_search.c \
+../../src/tests/test_interpolation_search.c \
 ../../src/tests/test_stack.c \
+../../src/tests/test_lf_stack.c \
 ../../src/tests/test_lexical_tree.c \
 ../../src/tests/test_vector.c \
+../../src/tests/test_mmap_vector.c \
 ../../src/tests/test_avl_tree.c \
-../../src/tests/test_rb_tree.c
+../../src/tests/test_rb_tree.c \
+../../src/tests/bench_fixed_alloc.c \
+../../src/tests/bench_mt_fixed_alloc.c \
+../../src/tests/bench_vector.c \
+../../src/tests/bench_stack.c \
+../../src/tests/bench_lf_stack.c \
+../../src/tests/bench_bsearch.c \
+../../src/tests/bench_interpolation_search.c
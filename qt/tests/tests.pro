@@ -7,3 +7,4 @@ QT -= core \
 include(../templates.pri)
 include(../utilities.pri)
 include(tests.pri)
+unix:LIBS += -lpthread
@@ -1,7 +1,9 @@
 HEADERS += ../../src/utilities/alloc.h \
 ../../src/utilities/ut/ut.h \
-../../src/utilities/ut/ut_utility.h
+../../src/utilities/ut/ut_utility.h \
+../../src/utilities/ut/ut_bench.h
 
 SOURCES += ../../src/utilities/alloc.c \
 ../../src/utilities/ut/ut.c \
-../../src/utilities/ut/ut_utility.c
+../../src/utilities/ut/ut_utility.c \
+../../src/utilities/ut/ut_bench.c
@@ -22,10 +22,18 @@
  *  AVL_TREE_IS_VALID_TREE_REQUIRED - specifies, that is_tree_valid function is required
  *  AVL_TREE_PRINT_NODE - print macro, that shall be defined to make AVL_TREE_PRINT_TREE_REQUIRED work
  *  AVL_TREE_INITIAL_CHUNK_SIZE - defines initial chunk size in bytes for internally used nodes allocator
+ *  AVL_TREE_MAX_CHUNK_SIZE - if defined, nodes allocator doubles chunk size on each allocation up to this value
+ *  AVL_TREE_RELEASE_EMPTY_CLUSTERS - specifies that nodes allocator returns unused memory to the system after nodes removal
+ *  AVL_TREE_XMALLOC_ALIGNED(size, alignment) - aligned allocation function for the nodes allocator clusters,
+ *                     it takes effect only if AVL_TREE_REMOVE_NODE_REQUIRED is defined
+ *  AVL_TREE_XFREE_ALIGNED - memory releasing function for the AVL_TREE_XMALLOC_ALIGNED
+ *  AVL_TREE_MMAP_REGIONS - specifies that nodes allocator maps its memory with mmap in large regions backed by huge pages
+ *                     where available, it takes effect only if AVL_TREE_REMOVE_NODE_REQUIRED is defined
  *  AVL_TREE_USER_DATA_TYPE - defines user data to be added to the node
  *  AVL_TREE_COUNT_REQUIRED - specifies that nodes count shall be provided
  *  AVL_TREE_FOREACH_REQUIRED - specifies, that tree_foreach function is required
  *  AVL_TREE_CLEAR_REQUIRED - specifies that tree_clear function is required
+ *  AVL_TREE_CLEAR_RETAINED_SIZE - count of nodes tree_clear keeps memory for, all the memory is kept by default
  *  AVL_TREE_ASSERT - specifies assertion macro
  *
  * unmasked types/functions:
@@ -155,8 +163,34 @@ typedef struct AVL_TREE_NS(node)
 #define FIXED_ALLOC_INITIAL_CHUNK_SIZE  AVL_TREE_INITIAL_CHUNK_SIZE
 #endif
 
+#ifdef AVL_TREE_MAX_CHUNK_SIZE
+#define FIXED_ALLOC_MAX_CHUNK_SIZE  AVL_TREE_MAX_CHUNK_SIZE
+#endif
+
+#ifdef AVL_TREE_CLEAR_REQUIRED
+#define FIXED_ALLOC_CLEAR_REQUIRED
+#endif
+
+#ifdef AVL_TREE_CLEAR_RETAINED_SIZE
+#define FIXED_ALLOC_CLEAR_RETAINED_SIZE  AVL_TREE_CLEAR_RETAINED_SIZE
+#endif
+
 #ifdef AVL_TREE_REMOVE_NODE_REQUIRED
 #define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+/* constant-time lookup of the node's cluster on removal */
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#ifdef AVL_TREE_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#endif
+
+#ifdef AVL_TREE_XMALLOC_ALIGNED
+#define FIXED_ALLOC_XMALLOC_ALIGNED AVL_TREE_XMALLOC_ALIGNED
+#define FIXED_ALLOC_XFREE_ALIGNED   AVL_TREE_XFREE_ALIGNED
+#endif
+
+#ifdef AVL_TREE_MMAP_REGIONS
+#define FIXED_ALLOC_MMAP_REGIONS
+#endif
 #endif
 
 #ifdef AVL_TREE_IS_VALID_TREE_REQUIRED
@@ -836,8 +870,13 @@ static void AVL_TREE_NS(tree_foreach)(AVL_TREE_NS(tree) * tree,
 
 static void AVL_TREE_NS(tree_clear)(AVL_TREE_NS(tree) * tree)
 {
-    AVL_TREE_NS(uninit_tree)(tree);
-    AVL_TREE_NS(init_tree)(tree);
+    // nodes memory is kept for the subsequent insertions
+    AVL_FIXED_ALLOC_NS(allocator_clear)(&tree->allocator);
+    tree->root = &tree->sentinel;
+
+#ifdef AVL_TREE_COUNT_REQUIRED
+    tree->count = 0;
+#endif
 }
 
 #endif
@@ -863,7 +902,13 @@ static void AVL_TREE_NS(tree_clear)(AVL_TREE_NS(tree) * tree)
 #undef AVL_TREE_IS_VALID_TREE_REQUIRED
 #undef AVL_TREE_PRINT_NODE
 #undef AVL_TREE_INITIAL_CHUNK_SIZE
+#undef AVL_TREE_MAX_CHUNK_SIZE
+#undef AVL_TREE_RELEASE_EMPTY_CLUSTERS
+#undef AVL_TREE_XMALLOC_ALIGNED
+#undef AVL_TREE_XFREE_ALIGNED
+#undef AVL_TREE_MMAP_REGIONS
 #undef AVL_TREE_USER_DATA_TYPE
 #undef AVL_TREE_COUNT_REQUIRED
 #undef AVL_TREE_FOREACH_REQUIRED
 #undef AVL_TREE_CLEAR_REQUIRED
+#undef AVL_TREE_CLEAR_RETAINED_SIZE
@@ -0,0 +1,115 @@
+/*
+ * portable bit operations over the unsigned long numbers.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * compiler intrinsics are used where available (gcc/clang builtins, msvc intrinsics),
+ * the other compilers get the generic implementation, that may be forced by defining BITOPS_FORCE_GENERIC.
+ *
+ * functions:
+ *  bitops_ctz          returns index of the lowest set bit, argument shall not be zero
+ *  bitops_popcount     returns count of the set bits
+ *
+ *  bitops_internal_ctz_generic         internal function
+ *  bitops_internal_popcount_generic    internal function
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <limits.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * returns index of the lowest set bit by means of the portable code
+ * \param x     source number, shall not be zero
+ * \return index of the lowest set bit
+ */
+static inline size_t bitops_internal_ctz_generic(unsigned long x)
+{
+    size_t result = 0;
+    size_t width = sizeof(unsigned long) * CHAR_BIT / 2;
+
+    /* bisect the number, dropping the lower half each time it is zero */
+    for (; width > 0; width = width / 2)
+    {
+        unsigned long lower_mask = ULONG_MAX >> (sizeof(unsigned long) * CHAR_BIT - width);
+        if (0 == (x & lower_mask))
+        {
+            x = x >> width;
+            result += width;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * returns count of the set bits by means of the portable code
+ * \param x     source number
+ * \return count of the bits set in the given number
+ */
+static inline size_t bitops_internal_popcount_generic(unsigned long x)
+{
+    size_t result = 0;
+
+    /* count bits in each byte in parallel, then sum the bytes */
+    while (0 != x)
+    {
+        unsigned long v = x & 0xFFFFFFFFUL;
+
+        v = v - ((v >> 1) & 0x55555555UL);
+        v = (v & 0x33333333UL) + ((v >> 2) & 0x33333333UL);
+        v = (v + (v >> 4)) & 0x0F0F0F0FUL;
+        result += (size_t)(((v * 0x01010101UL) & 0xFFFFFFFFUL) >> 24);
+
+        /* shift by two steps to avoid undefined shift by the full width of 32-bit long */
+        x = (x >> 16) >> 16;
+    }
+
+    return result;
+}
+
+/**
+ * returns index of the lowest set bit
+ * \param x     source number, shall not be zero
+ * \return index of the lowest set bit
+ */
+static inline size_t bitops_ctz(unsigned long x)
+{
+#if defined(BITOPS_FORCE_GENERIC)
+    return bitops_internal_ctz_generic(x);
+#elif defined(__GNUC__)
+    return (size_t)__builtin_ctzl(x);
+#elif defined(_MSC_VER)
+    /* unsigned long is 32-bit wide for msvc */
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return (size_t)index;
+#else
+    return bitops_internal_ctz_generic(x);
+#endif
+}
+
+/**
+ * returns count of the set bits
+ * \param x     source number
+ * \return count of the bits set in the given number
+ */
+static inline size_t bitops_popcount(unsigned long x)
+{
+#if defined(BITOPS_FORCE_GENERIC)
+    return bitops_internal_popcount_generic(x);
+#elif defined(__GNUC__)
+    return (size_t)__builtin_popcountl(x);
+#elif defined(_MSC_VER)
+    /* unsigned long is 32-bit wide for msvc */
+    return (size_t)__popcnt(x);
+#else
+    return bitops_internal_popcount_generic(x);
+#endif
+}
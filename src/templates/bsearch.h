@@ -18,9 +18,31 @@
  *
  * optional macros:
  *  BSEARCH_NS - namespace macro
+ *  BSEARCH_BOUNDS_REQUIRED - specifies that lower_bound, upper_bound and equal_range functions are required
+ *  BSEARCH_BRANCHLESS_REQUIRED - specifies that branchless_lower_bound and branchless_binary_search functions
+ *                                are required
+ *  BSEARCH_BATCH_REQUIRED - specifies that binary_search_batch function is required
+ *  BSEARCH_PREFETCH(array, index) - prefetches an array's element at the given position,
+ *                                   used by the branchless functions, e.g. __builtin_prefetch(&array[index])
+ *  BSEARCH_BATCH_SIZE - only for BSEARCH_BATCH_REQUIRED, count of keys which searches are advanced in lockstep
+ *                       by binary_search_batch, 16 by default
+ *  BSEARCH_SIMD_THRESHOLD - count of elements below what binary_search, lower_bound and branchless_lower_bound
+ *                           search the array by means of simd_search.h, it may be defined only if
+ *                           the array is the pointer to the arithmetic keys ordered by the built-in operators
  *
  * unmasked types/functions:
  *  binary_search               performs binary search over the array given
+ *  lower_bound                 returns index of the first element that is not less than the key
+ *  upper_bound                 returns index of the first element that is greater than the key
+ *  equal_range                 returns range of the elements that are equal to the key
+ *  branchless_lower_bound      lower_bound that avoids unpredictable branches, for the large arrays
+ *  branchless_binary_search    binary_search that avoids unpredictable branches, for the large arrays
+ *  binary_search_batch         performs branchless_binary_search for each of the keys given
+ *
+ *  internal_lower_bound        internal function
+ *  internal_upper_bound        internal function
+ *  internal_simd_lower_bound   internal function, simd_search.h instantiation if BSEARCH_SIMD_THRESHOLD is defined
+ *  internal_simd_binary_search internal function, simd_search.h instantiation if BSEARCH_SIMD_THRESHOLD is defined
  *
  *
  * Alexander Shabanov, 2009-2010
@@ -45,6 +67,22 @@
 #error BSEARCH_3W_COMPARE(array, index, key) is not defined
 #endif
 
+#ifndef BSEARCH_PREFETCH
+#define BSEARCH_PREFETCH(array, index) ((void)(index))
+#endif
+
+#if defined(BSEARCH_BATCH_REQUIRED) && !defined(BSEARCH_BATCH_SIZE)
+#define BSEARCH_BATCH_SIZE (16)
+#endif
+
+#include <stddef.h>
+
+#ifdef BSEARCH_SIMD_THRESHOLD
+#define SIMD_SEARCH_NS(name)    BSEARCH_NS(internal_##name)
+#define SIMD_SEARCH_KEY_TYPE    BSEARCH_KEY_TYPE
+#include "simd_search.h"
+#endif
+
 
 /**
  * performs binary search over the array given
@@ -56,13 +94,20 @@
  *                      binary negation of the target index
  *                      before what the source element is to be inserted
  */
-static int
+static inline int
 BSEARCH_NS(binary_search)(BSEARCH_ARRAY_TYPE array, int count, BSEARCH_KEY_TYPE key)
 {
     int begin = 0;
     int end = count - 1;
     int result;
 
+#ifdef BSEARCH_SIMD_THRESHOLD
+    if (count < BSEARCH_SIMD_THRESHOLD)
+    {
+        return (int)BSEARCH_NS(internal_simd_binary_search)(array, (size_t)count, key);
+    }
+#endif
+
     for (;;)
     {
         if (begin > end)
@@ -96,6 +141,290 @@ BSEARCH_NS(binary_search)(BSEARCH_ARRAY_TYPE array, int count, BSEARCH_KEY_TYPE
     return result;
 }
 
+#ifdef BSEARCH_BOUNDS_REQUIRED
+
+/**
+ * finds the first element of the sorted array's range that is not less than the key given
+ * \param array         source array
+ * \param begin         index of the first element of the range
+ * \param count         count of elements in the range
+ * \param key           key value to be searched
+ * \returns int         index of the found element or the index that follows the range
+ */
+static int
+BSEARCH_NS(internal_lower_bound)(BSEARCH_ARRAY_TYPE array, int begin, int count, BSEARCH_KEY_TYPE key)
+{
+    while (count > 0)
+    {
+        int half = count / 2;
+
+        if (BSEARCH_3W_COMPARE(array, begin + half, key) > 0)
+        {
+            // element is less than the key, so the rest of the array is to be searched
+            begin += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    return begin;
+}
+
+/**
+ * finds the first element of the sorted array's range that is greater than the key given
+ * \param array         source array
+ * \param begin         index of the first element of the range
+ * \param count         count of elements in the range
+ * \param key           key value to be searched
+ * \returns int         index of the found element or the index that follows the range
+ */
+static int
+BSEARCH_NS(internal_upper_bound)(BSEARCH_ARRAY_TYPE array, int begin, int count, BSEARCH_KEY_TYPE key)
+{
+    while (count > 0)
+    {
+        int half = count / 2;
+
+        if (BSEARCH_3W_COMPARE(array, begin + half, key) >= 0)
+        {
+            // element is not greater than the key, so the rest of the array is to be searched
+            begin += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    return begin;
+}
+
+/**
+ * finds the first element of the sorted array that is not less than the key given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns int         index of the found element or count if all the elements are less than the key
+ */
+static inline int
+BSEARCH_NS(lower_bound)(BSEARCH_ARRAY_TYPE array, int count, BSEARCH_KEY_TYPE key)
+{
+#ifdef BSEARCH_SIMD_THRESHOLD
+    if (count < BSEARCH_SIMD_THRESHOLD)
+    {
+        return (int)BSEARCH_NS(internal_simd_lower_bound)(array, (size_t)count, key);
+    }
+#endif
+
+    return BSEARCH_NS(internal_lower_bound)(array, 0, count, key);
+}
+
+/**
+ * finds the first element of the sorted array that is greater than the key given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns int         index of the found element or count if none of the elements is greater than the key
+ */
+static inline int
+BSEARCH_NS(upper_bound)(BSEARCH_ARRAY_TYPE array, int count, BSEARCH_KEY_TYPE key)
+{
+    return BSEARCH_NS(internal_upper_bound)(array, 0, count, key);
+}
+
+/**
+ * finds the range of the sorted array's elements that are equal to the key given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \param first         receives index of the first element that is equal to the key, or
+ *                      the index before what the key is to be inserted if there are no such elements
+ * \param last          receives index of the element that follows the last element equal to the key,
+ *                      it is equal to the first index if there are no such elements
+ */
+static inline void
+BSEARCH_NS(equal_range)(BSEARCH_ARRAY_TYPE array, int count, BSEARCH_KEY_TYPE key, int * first, int * last)
+{
+    int begin = 0;
+
+    // narrow the range until the element equal to the key is found, then search both bounds around it
+    while (count > 0)
+    {
+        int half = count / 2;
+        int cmpret = BSEARCH_3W_COMPARE(array, begin + half, key);
+
+        if (cmpret > 0)
+        {
+            begin += half + 1;
+            count -= half + 1;
+        }
+        else if (cmpret < 0)
+        {
+            count = half;
+        }
+        else
+        {
+            int mid = begin + half;
+            *first = BSEARCH_NS(internal_lower_bound)(array, begin, half, key);
+            *last = BSEARCH_NS(internal_upper_bound)(array, mid + 1, count - half - 1, key);
+            return;
+        }
+    }
+
+    *first = begin;
+    *last = begin;
+}
+
+#endif // BSEARCH_BOUNDS_REQUIRED
+
+#ifdef BSEARCH_BRANCHLESS_REQUIRED
+
+/**
+ * finds the first element of the sorted array that is not less than the key given,
+ * the search range is halved on each step regardless of the comparison result, so the step is
+ * compiled to the conditional move instead of the branch, both elements that may be compared
+ * on the next step are prefetched
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns size_t      index of the found element or count if all the elements are less than the key
+ */
+static size_t
+BSEARCH_NS(branchless_lower_bound)(BSEARCH_ARRAY_TYPE array, size_t count, BSEARCH_KEY_TYPE key)
+{
+    size_t base = 0;
+
+#ifdef BSEARCH_SIMD_THRESHOLD
+    if (count < BSEARCH_SIMD_THRESHOLD)
+    {
+        return BSEARCH_NS(internal_simd_lower_bound)(array, count, key);
+    }
+#endif
+
+    if (0 == count)
+    {
+        return 0;
+    }
+
+    while (count > 1)
+    {
+        size_t half = count / 2;
+        size_t next_half = (count - half) / 2;
+
+        BSEARCH_PREFETCH(array, base + next_half);
+        BSEARCH_PREFETCH(array, base + half + next_half);
+
+        // element is less than the key, so the upper part of the range is to be searched
+        base = (BSEARCH_3W_COMPARE(array, base + half, key) > 0) ? base + half : base;
+        count -= half;
+    }
+
+    return base + (BSEARCH_3W_COMPARE(array, base, key) > 0);
+}
+
+/**
+ * performs binary search over the array given by means of branchless_lower_bound
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns ptrdiff_t   non-negative index of the first corresponding array element
+ *                      if such exists, or negative value that represents
+ *                      binary negation of the target index
+ *                      before what the source element is to be inserted
+ */
+static inline ptrdiff_t
+BSEARCH_NS(branchless_binary_search)(BSEARCH_ARRAY_TYPE array, size_t count, BSEARCH_KEY_TYPE key)
+{
+    size_t index = BSEARCH_NS(branchless_lower_bound)(array, count, key);
+
+    if ((index < count) && (0 == BSEARCH_3W_COMPARE(array, index, key)))
+    {
+        return (ptrdiff_t)index;
+    }
+
+    return ~(ptrdiff_t)index;
+}
+
+#endif // BSEARCH_BRANCHLESS_REQUIRED
+
+#ifdef BSEARCH_BATCH_REQUIRED
+
+/**
+ * performs binary search over the array given for each of the keys given,
+ * the searches of the batch of keys are advanced in lockstep, so the memory accesses of the different
+ * searches are interleaved and the cache misses are served in parallel instead of one by one,
+ * the element that is compared by the search on the next step is prefetched
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param keys          key values to be searched
+ * \param key_count     count of keys
+ * \param results       receives key_count results, each of them is the same as one of branchless_binary_search
+ */
+static void
+BSEARCH_NS(binary_search_batch)(BSEARCH_ARRAY_TYPE array, size_t count,
+                                const BSEARCH_KEY_TYPE * keys, size_t key_count, ptrdiff_t * results)
+{
+    size_t bases[BSEARCH_BATCH_SIZE];
+    size_t first;
+
+    for (first = 0; first < key_count; first += BSEARCH_BATCH_SIZE)
+    {
+        size_t batch_count = key_count - first < BSEARCH_BATCH_SIZE ? key_count - first : BSEARCH_BATCH_SIZE;
+        size_t range = count;
+        size_t i;
+
+        for (i = 0; i < batch_count; ++i)
+        {
+            bases[i] = 0;
+        }
+
+        // the ranges of all the searches are of the same size, so they take the same count of steps
+        while (range > 1)
+        {
+            size_t half = range / 2;
+            size_t next_half = (range - half) / 2;
+
+            for (i = 0; i < batch_count; ++i)
+            {
+                BSEARCH_KEY_TYPE key = keys[first + i];
+                size_t base = bases[i];
+
+                base = (BSEARCH_3W_COMPARE(array, base + half, key) > 0) ? base + half : base;
+                BSEARCH_PREFETCH(array, base + next_half);
+                bases[i] = base;
+            }
+
+            range -= half;
+        }
+
+        for (i = 0; i < batch_count; ++i)
+        {
+            BSEARCH_KEY_TYPE key = keys[first + i];
+            size_t index = 0;
+
+            if (0 != count)
+            {
+                index = bases[i] + (BSEARCH_3W_COMPARE(array, bases[i], key) > 0);
+            }
+
+            if ((index < count) && (0 == BSEARCH_3W_COMPARE(array, index, key)))
+            {
+                results[first + i] = (ptrdiff_t)index;
+            }
+            else
+            {
+                results[first + i] = ~(ptrdiff_t)index;
+            }
+        }
+    }
+}
+
+#endif // BSEARCH_BATCH_REQUIRED
+
 
 /*
  * undefine user macros
@@ -104,3 +433,9 @@ BSEARCH_NS(binary_search)(BSEARCH_ARRAY_TYPE array, int count, BSEARCH_KEY_TYPE
 #undef BSEARCH_ARRAY_TYPE
 #undef BSEARCH_KEY_TYPE
 #undef BSEARCH_3W_COMPARE
+#undef BSEARCH_BOUNDS_REQUIRED
+#undef BSEARCH_BRANCHLESS_REQUIRED
+#undef BSEARCH_BATCH_REQUIRED
+#undef BSEARCH_PREFETCH
+#undef BSEARCH_BATCH_SIZE
+#undef BSEARCH_SIMD_THRESHOLD
@@ -0,0 +1,187 @@
+/*
+ * template implementation of the search over the sorted array arranged in Eytzinger (BFS) order.
+ *
+ * the element at position k of the arranged array has its children at positions 2k and 2k+1,
+ * the first element is placed at position 1, so the position 0 is unused.
+ * the search descends from the root to the leaves touching the elements that are close to each other
+ * at the top levels of the tree, and the descendants of the element several levels below it occupy
+ * the adjacent positions, so they are prefetched by a single cache line request well before they are needed.
+ * it is best suited for the read-only lookup tables that are arranged once and searched many times.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  EYTZINGER_ELEMENT_TYPE - defines element type of the array
+ *  EYTZINGER_KEY_TYPE - defines key type which index is to be searched in an array
+ *  EYTZINGER_3W_COMPARE(array, index, key) - three-way comparison function -
+ *                                            it shall return int value what is:
+ *                                            <0 if a key is less than an array's element at the given position
+ *                                            >0 if a key is greater than an array's element at the given position
+ *                                            ==0 if a key is equal to an array's element at the given position
+ *
+ * optional macros:
+ *  EYTZINGER_NS - namespace macro
+ *  EYTZINGER_PREFETCH(array, index) - prefetches an array's element at the given position,
+ *                                     e.g. __builtin_prefetch(&array[index]), the position may exceed
+ *                                     the array's bounds
+ *  EYTZINGER_PREFETCH_LEVELS - count of levels the search prefetches ahead, 4 by default,
+ *                              so that 16 descendants fill a cache line of 64 bytes for 4-byte elements
+ *
+ * unmasked types/functions:
+ *  eytzinger_arrange           arranges the sorted array in Eytzinger order
+ *  eytzinger_lower_bound       returns position of the first element that is not less than the key
+ *  eytzinger_search            returns position of the element that is equal to the key
+ *
+ *  internal_arrange            internal function
+ */
+
+/*
+ sample usage:
+
+    // define type names
+    #define EYTZINGER_NS(name)      int_##name
+    #define EYTZINGER_ELEMENT_TYPE  int
+    #define EYTZINGER_KEY_TYPE      int
+    #define EYTZINGER_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+    #define EYTZINGER_PREFETCH(array, index) __builtin_prefetch(&array[index])
+
+    #include <templates/eytzinger.h>
+
+    ...
+    // count + 1 elements, aligned to the cache line for the best prefetching results
+    int * layout = aligned_alloc(64, ...);
+
+    int_eytzinger_arrange(sorted, count, layout);
+
+    position = int_eytzinger_search(layout, count, 42);
+    if (position != 0)
+    {
+        // layout[position] is equal to 42
+    }
+ */
+
+#include <stddef.h>
+
+#include "bitops.h"
+
+#ifndef EYTZINGER_NS
+#define EYTZINGER_NS(name) name
+#endif
+
+#ifndef EYTZINGER_ELEMENT_TYPE
+#error EYTZINGER_ELEMENT_TYPE is not defined
+#endif
+
+#ifndef EYTZINGER_KEY_TYPE
+#error EYTZINGER_KEY_TYPE is not defined
+#endif
+
+#ifndef EYTZINGER_3W_COMPARE
+#error EYTZINGER_3W_COMPARE(array, index, key) is not defined
+#endif
+
+#ifndef EYTZINGER_PREFETCH
+#define EYTZINGER_PREFETCH(array, index) ((void)(index))
+#endif
+
+#ifndef EYTZINGER_PREFETCH_LEVELS
+#define EYTZINGER_PREFETCH_LEVELS (4)
+#endif
+
+
+/**
+ * places the sorted elements to the subtree of the arranged array in order
+ * \param sorted        source sorted array
+ * \param next          index of the next sorted element to be placed
+ * \param layout        destination array
+ * \param position      position of the subtree's root
+ * \param count         count of elements
+ * \returns size_t      index of the sorted element that follows the placed ones
+ */
+static size_t
+EYTZINGER_NS(internal_arrange)(const EYTZINGER_ELEMENT_TYPE * sorted, size_t next,
+                               EYTZINGER_ELEMENT_TYPE * layout, size_t position, size_t count)
+{
+    // the depth of recursion is limited by the height of the tree
+    if (position <= count)
+    {
+        next = EYTZINGER_NS(internal_arrange)(sorted, next, layout, 2 * position, count);
+        layout[position] = sorted[next++];
+        next = EYTZINGER_NS(internal_arrange)(sorted, next, layout, 2 * position + 1, count);
+    }
+
+    return next;
+}
+
+/**
+ * arranges the sorted array in Eytzinger order
+ * \param sorted        source sorted array
+ * \param count         count of elements in the source array
+ * \param layout        destination array that is able to hold count + 1 elements,
+ *                      the elements are placed to the positions 1..count
+ */
+static void
+EYTZINGER_NS(eytzinger_arrange)(const EYTZINGER_ELEMENT_TYPE * sorted, size_t count, EYTZINGER_ELEMENT_TYPE * layout)
+{
+    EYTZINGER_NS(internal_arrange)(sorted, 0, layout, 1, count);
+}
+
+/**
+ * finds the first element of the arranged array that is not less than the key given
+ * \param array         arranged array
+ * \param count         count of elements in the arranged array
+ * \param key           key value to be searched
+ * \returns size_t      position of the found element in the arranged array
+ *                      or 0 if all the elements are less than the key
+ */
+static size_t
+EYTZINGER_NS(eytzinger_lower_bound)(const EYTZINGER_ELEMENT_TYPE * array, size_t count, EYTZINGER_KEY_TYPE key)
+{
+    size_t position = 1;
+
+    while (position <= count)
+    {
+        EYTZINGER_PREFETCH(array, position << EYTZINGER_PREFETCH_LEVELS);
+
+        // go to the right child if the element is less than the key
+        position = 2 * position + (EYTZINGER_3W_COMPARE(array, position, key) > 0);
+    }
+
+    // the path is ended by the right turns after the last left turn made at the found element,
+    // drop them along with that left turn
+    return position >> (bitops_ctz(~(unsigned long)position) + 1);
+}
+
+/**
+ * finds the element of the arranged array that is equal to the key given
+ * \param array         arranged array
+ * \param count         count of elements in the arranged array
+ * \param key           key value to be searched
+ * \returns size_t      position of the found element in the arranged array, or 0 if there is no such element
+ */
+static inline size_t
+EYTZINGER_NS(eytzinger_search)(const EYTZINGER_ELEMENT_TYPE * array, size_t count, EYTZINGER_KEY_TYPE key)
+{
+    size_t position = EYTZINGER_NS(eytzinger_lower_bound)(array, count, key);
+
+    if ((0 != position) && (0 == EYTZINGER_3W_COMPARE(array, position, key)))
+    {
+        return position;
+    }
+
+    return 0;
+}
+
+
+/*
+ * undefine user macros
+ */
+#undef EYTZINGER_NS
+#undef EYTZINGER_ELEMENT_TYPE
+#undef EYTZINGER_KEY_TYPE
+#undef EYTZINGER_3W_COMPARE
+#undef EYTZINGER_PREFETCH
+#undef EYTZINGER_PREFETCH_LEVELS
@@ -17,10 +17,51 @@
  *  FIXED_ALLOC_FREE_FUNCTION_REQUIRED - if defined, allocator will be capable to free elements, free function will be available
  *  FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED - if defined, get status function will be made available
  *  FIXED_ALLOC_INITIAL_CHUNK_SIZE - defines initial chunk size in bytes for allocator without "free capabilities", in chunks for the other
+ *  FIXED_ALLOC_MAX_CHUNK_SIZE - if defined, each subsequently allocated chunk (cluster for the allocator with
+ *                               "free capabilities") is twice as big as the previous one, starting from
+ *                               FIXED_ALLOC_INITIAL_CHUNK_SIZE up to this value, measured in the same units,
+ *                               note that FIXED_ALLOC_ALIGNED_CLUSTERS aligns every cluster for the largest
+ *                               cluster size, so each cluster reserves an extra space of that size
+ *                               (or occupies a whole largest cluster slot of the FIXED_ALLOC_MMAP_REGIONS region)
+ *                               unless FIXED_ALLOC_XMALLOC_ALIGNED is defined
  *  FIXED_ALLOC_CHUNK_NUM_BITS - only for allocator with "free-element" capabilities, defines bits count in an unsigned int number
  *  FIXED_ALLOC_FOREACH_REQUIRED - specifies that foreach function is required
- *  FIXED_ALLOC_CLEAR_REQUIRED - specifies that allocator_clear is required
+ *  FIXED_ALLOC_CLEAR_REQUIRED - specifies that allocator_clear is required, it disposes all the allocated elements
+ *                               and keeps allocated memory for the subsequent allocations
+ *  FIXED_ALLOC_CLEAR_RETAINED_SIZE - only for FIXED_ALLOC_CLEAR_REQUIRED, count of elements allocator_clear keeps
+ *                               memory for, the most recently allocated chunks (clusters) are kept until their
+ *                               capacity reaches this value, the rest is returned to the system
+ *  FIXED_ALLOC_BATCH_REQUIRED - specifies that alloc_elem_n and free_elem_n (the latter is only for allocator with
+ *                               "free-element" capabilities) are required, these take or release all the elements
+ *                               of the chunk at once
+ *  FIXED_ALLOC_BATCH_ONLY - only for FIXED_ALLOC_BATCH_REQUIRED and allocator with "free-element" capabilities,
+ *                               specifies that alloc_elem and free_elem are not required
  *  FIXED_ALLOC_ASSERT - specifies assertion
+ *  FIXED_ALLOC_ALIGNED_CLUSTERS - only for allocator with "free-element" capabilities, places every cluster
+ *                                 at the address aligned to the power of two that is not less than the cluster size,
+ *                                 so that free_elem finds the owning cluster by masking the element's address
+ *                                 instead of walking through the list of clusters
+ *  FIXED_ALLOC_XMALLOC_ALIGNED(size, alignment) - optional aligned allocation function that will never return 0,
+ *                                 if it is not defined, FIXED_ALLOC_ALIGNED_CLUSTERS allocates each cluster
+ *                                 with FIXED_ALLOC_XMALLOC with an extra space of the alignment size
+ *  FIXED_ALLOC_XFREE_ALIGNED - memory releasing function for the FIXED_ALLOC_XMALLOC_ALIGNED
+ *  FIXED_ALLOC_SEPARATE_MASKS - only for allocator with "free-element" capabilities, keeps free masks of all the
+ *                               cluster's chunks contiguous and places elements payload after them,
+ *                               by default every chunk holds its free mask right before its elements
+ *  FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS - only for allocator with "free-element" capabilities, specifies that
+ *                               clusters that have no allocated elements are returned back to the system
+ *  FIXED_ALLOC_RETAINED_EMPTY_CLUSTERS - only for FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS, count of empty clusters
+ *                               that are kept by allocator to avoid releasing and allocating the cluster again
+ *                               on the alloc/free sequence at the cluster's boundary, 1 by default
+ *  FIXED_ALLOC_PAYLOAD_ALIGNMENT - only for FIXED_ALLOC_SEPARATE_MASKS, power of two the offset of the payload
+ *                               from the cluster's start is rounded up to, e.g. page size,
+ *                               combined with FIXED_ALLOC_ALIGNED_CLUSTERS the payload address itself is aligned
+ *  FIXED_ALLOC_MMAP_REGIONS - only for allocator with "free-element" capabilities, implies FIXED_ALLOC_ALIGNED_CLUSTERS,
+ *                               clusters are carved from the large aligned regions mapped by mmap and advised
+ *                               to be backed by transparent huge pages, region is unmapped once all its clusters
+ *                               are released, if mmap is not available or fails FIXED_ALLOC_XMALLOC is used
+ *  FIXED_ALLOC_MMAP_REGION_SIZE - only for FIXED_ALLOC_MMAP_REGIONS, power of two size of the region in bytes,
+ *                               4 megabytes by default, the region holds at least one cluster
  *
  * unmasked types/functions:
  *  allocator                       allocator structure
@@ -28,16 +69,40 @@
  *  uninit_allocator                uninitializes allocator
  *  alloc_elem                      allocates new element
  *  free_elem                       disposes element given that was previously allocated by this allocator
+ *  alloc_elem_n                    allocates the given count of elements
+ *  free_elem_n                     disposes the given elements
  *  get_allocator_status            retrieves allocator status
  *  allocator_foreach               enumerates allocated elements
- *  allocator_clear                 disposes all the allocated elements
+ *  allocator_clear                 disposes all the allocated elements keeping the memory
  *
  *  internal_chunk                  internally used chunk structure
  *  internal_chunk_cluster          internally used chunk cluster structure
  *  internal_create_allocator       internal function
+ *  internal_get_cluster_size       internal function
+ *  internal_get_chunk_capacity     internal function
+ *  internal_free_chunks            internal function
+ *  internal_reset_cluster          internal function
+ *  internal_create_cluster         internal function
+ *  internal_free_cluster           internal function
+ *  internal_region                 internally used mmap region structure
+ *  internal_map_cluster            internal function
+ *  internal_unmap_cluster          internal function
+ *  internal_link_free_cluster      internal function
+ *  internal_unlink_free_cluster    internal function
+ *  internal_release_cluster        internal function
+ *  internal_find_cluster           internal function
+ *  internal_get_full_mask_size     internal function
+ *  internal_get_payload_offset     internal function
+ *  internal_get_free_mask          internal function
+ *  internal_get_elem               internal function
+ *  internal_find_zero_bit          internal function
  *  internal_alloc_elem_from_chunk  internal function
+ *  internal_find_free_chunk        internal function
  *  internal_find_free_elem         internal function
- *  internal_get_bits_count         internal function - get bits count from the number given, to be removed to the separate header
+ *  internal_note_allocated         internal function
+ *  internal_locate_elem            internal function
+ *  internal_free_chunk_bits        internal function
+ *  internal_get_bits_count         internal function - get bits count from the number given
  *
  * Alexander Shabanov, 2008-2009
  * mailto:avshabanov@gmail.com
@@ -73,6 +138,7 @@
     int_uninit_allocator(&intallocator);
  */
 
+#include <stddef.h>
 #include <string.h>
 
 
@@ -108,6 +174,14 @@
 #error FIXED_ALLOC_XFREE is not defined
 #endif
 
+#if defined(FIXED_ALLOC_XMALLOC_ALIGNED) && !defined(FIXED_ALLOC_XFREE_ALIGNED)
+#error FIXED_ALLOC_XFREE_ALIGNED is not defined
+#endif
+
+#if defined(FIXED_ALLOC_BATCH_ONLY) && !defined(FIXED_ALLOC_BATCH_REQUIRED)
+#error FIXED_ALLOC_BATCH_REQUIRED is not defined
+#endif
+
 /*
  * initial cache size
  */
@@ -125,22 +199,85 @@
  */
 typedef struct FIXED_ALLOC_NS(internal_chunk)
 {
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    size_t               size;
+    size_t               capacity;
+    struct FIXED_ALLOC_NS(internal_chunk) * prev;
+    FIXED_ALLOC_ELEMENT_TYPE   arr[1];
+#else
     FIXED_ALLOC_ELEMENT_TYPE   arr[FIXED_ALLOC_INITIAL_CHUNK_SIZE];
     size_t               size;
     struct FIXED_ALLOC_NS(internal_chunk) * prev;
+#endif
 } FIXED_ALLOC_NS(internal_chunk);
 
 typedef struct FIXED_ALLOC_NS(allocator)
 {
     FIXED_ALLOC_NS(internal_chunk) * chunk;
+
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    /*
+     * capacity of the chunk to be allocated next
+     */
+    size_t                           next_capacity;
+#endif
+
+#ifdef FIXED_ALLOC_CLEAR_REQUIRED
+    /*
+     * chunks kept by allocator_clear for the subsequent allocations
+     */
+    FIXED_ALLOC_NS(internal_chunk) * spare_chunk;
+#endif
 } FIXED_ALLOC_NS(allocator);
 
+/*
+ * returns count of elements the chunk is able to hold
+ */
+static inline size_t
+FIXED_ALLOC_NS(internal_get_chunk_capacity)(FIXED_ALLOC_NS(internal_chunk) * chunk)
+{
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    return chunk->capacity;
+#else
+    (void)chunk;
+    return FIXED_ALLOC_INITIAL_CHUNK_SIZE;
+#endif
+}
+
 static FIXED_ALLOC_NS(internal_chunk) *
-FIXED_ALLOC_NS(internal_create_chunk)(FIXED_ALLOC_NS(internal_chunk) * prev)
+FIXED_ALLOC_NS(internal_create_chunk)(FIXED_ALLOC_NS(allocator) * allocator)
 {
-    FIXED_ALLOC_NS(internal_chunk) * chunk = FIXED_ALLOC_XMALLOC(sizeof(FIXED_ALLOC_NS(internal_chunk)));
+    FIXED_ALLOC_NS(internal_chunk) * chunk;
+
+#ifdef FIXED_ALLOC_CLEAR_REQUIRED
+    if (NULL != allocator->spare_chunk)
+    {
+        // reuse the chunk kept by allocator_clear
+        chunk = allocator->spare_chunk;
+        allocator->spare_chunk = chunk->prev;
+    }
+    else
+#endif
+    {
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+        const size_t capacity = allocator->next_capacity;
+
+        chunk = FIXED_ALLOC_XMALLOC(offsetof(FIXED_ALLOC_NS(internal_chunk), arr) + capacity * sizeof(FIXED_ALLOC_ELEMENT_TYPE));
+        chunk->capacity = capacity;
+
+        // next chunk will be twice as big
+        if (capacity < FIXED_ALLOC_MAX_CHUNK_SIZE)
+        {
+            allocator->next_capacity = (2 * capacity < FIXED_ALLOC_MAX_CHUNK_SIZE ? 2 * capacity : FIXED_ALLOC_MAX_CHUNK_SIZE);
+        }
+#else
+        chunk = FIXED_ALLOC_XMALLOC(sizeof(FIXED_ALLOC_NS(internal_chunk)));
+#endif
+    }
+
     chunk->size = 0;
-    chunk->prev = prev;
+    chunk->prev = allocator->chunk;
+    allocator->chunk = chunk;
 
     return chunk;
 }
@@ -149,12 +286,23 @@ static void
 FIXED_ALLOC_NS(init_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
 {
     allocator->chunk = NULL;
+
+#ifdef FIXED_ALLOC_CLEAR_REQUIRED
+    allocator->spare_chunk = NULL;
+#endif
+
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    FIXED_ALLOC_ASSERT(FIXED_ALLOC_INITIAL_CHUNK_SIZE <= FIXED_ALLOC_MAX_CHUNK_SIZE);
+    allocator->next_capacity = FIXED_ALLOC_INITIAL_CHUNK_SIZE;
+#endif
 }
 
+/*
+ * releases the chunk given and all the previous ones
+ */
 static void
-FIXED_ALLOC_NS(uninit_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
+FIXED_ALLOC_NS(internal_free_chunks)(FIXED_ALLOC_NS(internal_chunk) * chunk)
 {
-    FIXED_ALLOC_NS(internal_chunk) * chunk = allocator->chunk;
     while (NULL != chunk)
     {
         FIXED_ALLOC_NS(internal_chunk) * prev = chunk->prev;
@@ -163,20 +311,68 @@ FIXED_ALLOC_NS(uninit_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
     }
 }
 
+static void
+FIXED_ALLOC_NS(uninit_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    FIXED_ALLOC_NS(internal_free_chunks)(allocator->chunk);
+
+#ifdef FIXED_ALLOC_CLEAR_REQUIRED
+    FIXED_ALLOC_NS(internal_free_chunks)(allocator->spare_chunk);
+#endif
+}
+
 static FIXED_ALLOC_ELEMENT_TYPE *
 FIXED_ALLOC_NS(alloc_elem)(FIXED_ALLOC_NS(allocator) * allocator)
 {
     FIXED_ALLOC_NS(internal_chunk) * chunk = allocator->chunk;
 
-    if (chunk == 0 || chunk->size >= FIXED_ALLOC_INITIAL_CHUNK_SIZE)
+    if (chunk == 0 || chunk->size >= FIXED_ALLOC_NS(internal_get_chunk_capacity)(chunk))
     {
-        chunk = FIXED_ALLOC_NS(internal_create_chunk)(chunk);
-        allocator->chunk = chunk;
+        chunk = FIXED_ALLOC_NS(internal_create_chunk)(allocator);
     }
 
     return &chunk->arr[chunk->size ++];
 }
 
+#ifdef FIXED_ALLOC_BATCH_REQUIRED
+
+/*
+ * allocates n elements and puts them to the given array
+ */
+static void
+FIXED_ALLOC_NS(alloc_elem_n)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELEMENT_TYPE ** elems, size_t n)
+{
+    FIXED_ALLOC_NS(internal_chunk) * chunk = allocator->chunk;
+
+    while (n > 0)
+    {
+        size_t count;
+        size_t i;
+
+        if (chunk == 0 || chunk->size >= FIXED_ALLOC_NS(internal_get_chunk_capacity)(chunk))
+        {
+            chunk = FIXED_ALLOC_NS(internal_create_chunk)(allocator);
+        }
+
+        // take as many elements as possible from the current chunk
+        count = FIXED_ALLOC_NS(internal_get_chunk_capacity)(chunk) - chunk->size;
+        if (count > n)
+        {
+            count = n;
+        }
+
+        for (i = 0; i < count; ++i)
+        {
+            *elems++ = &chunk->arr[chunk->size + i];
+        }
+
+        chunk->size += count;
+        n -= count;
+    }
+}
+
+#endif // FIXED_ALLOC_BATCH_REQUIRED
+
 #ifdef FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
 static void
 FIXED_ALLOC_NS(get_allocator_status)(FIXED_ALLOC_NS(allocator) * allocator, size_t * used, size_t * allocated)
@@ -189,7 +385,7 @@ FIXED_ALLOC_NS(get_allocator_status)(FIXED_ALLOC_NS(allocator) * allocator, size
     while (NULL != c)
     {
         *used += c->size;
-        *allocated += FIXED_ALLOC_INITIAL_CHUNK_SIZE;
+        *allocated += FIXED_ALLOC_NS(internal_get_chunk_capacity)(c);
 
         c = c->prev;
     }
@@ -219,10 +415,47 @@ FIXED_ALLOC_NS(allocator_foreach)(FIXED_ALLOC_NS(allocator) * allocator, void *
 
 #endif // FIXED_ALLOC_FOREACH_REQUIRED
 
+#ifdef FIXED_ALLOC_CLEAR_REQUIRED
+
+static void
+FIXED_ALLOC_NS(allocator_clear)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    FIXED_ALLOC_NS(internal_chunk) * chunk = allocator->chunk;
+#ifdef FIXED_ALLOC_CLEAR_RETAINED_SIZE
+    size_t retained = 0;
+#endif
+
+    // move all the chunks to the list of spare ones
+    while (NULL != chunk)
+    {
+        FIXED_ALLOC_NS(internal_chunk) * prev = chunk->prev;
+
+#ifdef FIXED_ALLOC_CLEAR_RETAINED_SIZE
+        if (retained >= FIXED_ALLOC_CLEAR_RETAINED_SIZE)
+        {
+            FIXED_ALLOC_NS(internal_free_chunks)(chunk);
+            break;
+        }
+
+        retained += FIXED_ALLOC_NS(internal_get_chunk_capacity)(chunk);
+#endif
+
+        chunk->prev = allocator->spare_chunk;
+        allocator->spare_chunk = chunk;
+        chunk = prev;
+    }
+
+    allocator->chunk = NULL;
+}
+
+#endif // FIXED_ALLOC_CLEAR_REQUIRED
+
 #else // FIXED_ALLOC_FREE_FUNCTION_REQUIRED defined
 
 #include <limits.h>
 
+#include "bitops.h"
+
 typedef unsigned long                   FIXED_ALLOC_NS(InternalMaskType);
 
 #if !defined(FIXED_ALLOC_MASK_TYPE_MAX)
@@ -234,17 +467,71 @@ typedef unsigned long                   FIXED_ALLOC_NS(InternalMaskType);
 #undef FIXED_ALLOC_CHUNK_NUM_BITS
 #define FIXED_ALLOC_CHUNK_NUM_BITS   (sizeof(FIXED_ALLOC_NS(InternalMaskType)) * CHAR_BIT)
 
+#if defined(FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS) && !defined(FIXED_ALLOC_RETAINED_EMPTY_CLUSTERS)
+#define FIXED_ALLOC_RETAINED_EMPTY_CLUSTERS (1)
+#endif
+
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+
+#ifdef FIXED_ALLOC_XMALLOC_ALIGNED
+#error FIXED_ALLOC_MMAP_REGIONS can not be combined with FIXED_ALLOC_XMALLOC_ALIGNED
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#else
+/* mmap is not available, clusters are allocated by FIXED_ALLOC_XMALLOC */
+#undef FIXED_ALLOC_MMAP_REGIONS
+#endif
+
+#ifndef FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#endif
+
+#ifndef FIXED_ALLOC_MMAP_REGION_SIZE
+#define FIXED_ALLOC_MMAP_REGION_SIZE (4 * 1024 * 1024)
+#endif
+
+#endif // FIXED_ALLOC_MMAP_REGIONS
+
 typedef struct FIXED_ALLOC_NS(internal_chunk)
 {
     FIXED_ALLOC_NS(InternalMaskType)        free_mask;
     FIXED_ALLOC_ELEMENT_TYPE arr[FIXED_ALLOC_CHUNK_NUM_BITS];
 } FIXED_ALLOC_NS(internal_chunk);
 
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+
+#ifndef FIXED_ALLOC_PAYLOAD_ALIGNMENT
+/*
+ * the offset of this helper's element gives alignment of the element type
+ */
+struct FIXED_ALLOC_NS(internal_alignment_helper)
+{
+    char                        c;
+    FIXED_ALLOC_ELEMENT_TYPE    e;
+};
+
+#define FIXED_ALLOC_PAYLOAD_ALIGNMENT   offsetof(struct FIXED_ALLOC_NS(internal_alignment_helper), e)
+#endif
+
+#endif // FIXED_ALLOC_SEPARATE_MASKS
+
 
 
 typedef struct FIXED_ALLOC_NS(internal_chunk_cluster)
 {
+    /*
+     * previously and subsequently allocated clusters
+     */
     struct FIXED_ALLOC_NS(internal_chunk_cluster) *    prev;
+    struct FIXED_ALLOC_NS(internal_chunk_cluster) *    next;
+
+    /*
+     * neighbours in the list of clusters that have at least one free element
+     */
+    struct FIXED_ALLOC_NS(internal_chunk_cluster) *    prev_free;
+    struct FIXED_ALLOC_NS(internal_chunk_cluster) *    next_free;
     
     /*
      * heuristic parameter:
@@ -252,131 +539,770 @@ typedef struct FIXED_ALLOC_NS(internal_chunk_cluster)
      */
     size_t                                              nfc_index;
 
+    /*
+     * count of elements allocated in this block
+     */
+    size_t                                              used;
+
+    /*
+     * count of chunks in this block
+     */
+    size_t                                              chunk_count;
+
+    /*
+     * summary bitmap, the bit is set if the corresponding chunk has no free elements,
+     * placed right after the chunks' free masks
+     */
+    FIXED_ALLOC_NS(InternalMaskType) *                  full_mask;
+
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+    /*
+     * elements of all the chunks
+     */
+    FIXED_ALLOC_ELEMENT_TYPE *                          payload;
+#endif
+
+#if defined(FIXED_ALLOC_ALIGNED_CLUSTERS) && !defined(FIXED_ALLOC_XMALLOC_ALIGNED)
+    /*
+     * pointer returned by FIXED_ALLOC_XMALLOC, the cluster itself is placed
+     * at the first suitably aligned address within this block
+     */
+    void *                                              origin;
+#endif
+
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+    /*
+     * region the cluster is carved from, NULL if the cluster is allocated by FIXED_ALLOC_XMALLOC
+     */
+    struct FIXED_ALLOC_NS(internal_region) *            region;
+#endif
+
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+    /*
+     * free masks of all the chunks, the elements payload follows them
+     */
+    FIXED_ALLOC_NS(InternalMaskType)                    free_masks[1];
+#else
     FIXED_ALLOC_NS(internal_chunk)                    chunks[1];
+#endif
 } FIXED_ALLOC_NS(internal_chunk_cluster);
 
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+/*
+ * descriptor of the mmap region, the region itself is divided into slots of the clusters alignment size
+ */
+typedef struct FIXED_ALLOC_NS(internal_region)
+{
+    /*
+     * neighbours in the list of regions that have at least one free slot
+     */
+    struct FIXED_ALLOC_NS(internal_region) *    prev;
+    struct FIXED_ALLOC_NS(internal_region) *    next;
+
+    char *                                      base;
+
+    /*
+     * count of slots that have been handed out at least once, the rest of slots are never touched
+     */
+    size_t                                      carved;
+
+    /*
+     * count of slots occupied by clusters
+     */
+    size_t                                      used;
+
+    /*
+     * list of released slots, linked through their first bytes
+     */
+    void *                                      free_slot;
+} FIXED_ALLOC_NS(internal_region);
+#endif
+
 typedef struct FIXED_ALLOC_NS(allocator)
 {
     FIXED_ALLOC_NS(internal_chunk_cluster) * cluster;
+
+    /*
+     * list of clusters that have at least one free element, linked by next_free
+     */
+    FIXED_ALLOC_NS(internal_chunk_cluster) * free_cluster;
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+    /*
+     * count of clusters that have no allocated elements
+     */
+    size_t                                   empty_clusters;
+#endif
+
+#ifdef FIXED_ALLOC_ALIGNED_CLUSTERS
+    /*
+     * power of two every cluster is aligned to
+     */
+    size_t                                   cluster_alignment;
+#endif
+
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    /*
+     * count of chunks in the cluster to be allocated next
+     */
+    size_t                                   next_chunk_count;
+#endif
+
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+    /*
+     * list of regions that have at least one free slot
+     */
+    FIXED_ALLOC_NS(internal_region) *        free_region;
+
+    /*
+     * size of every region, multiple of the clusters alignment
+     */
+    size_t                                   region_size;
+#endif
 } FIXED_ALLOC_NS(allocator);
 
-static void
-FIXED_ALLOC_NS(init_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
+/*
+ * returns count of mask words in the cluster's summary bitmap
+ */
+static inline size_t
+FIXED_ALLOC_NS(internal_get_full_mask_size)(size_t chunk_count)
 {
-    allocator->cluster = NULL;
+    return (chunk_count + FIXED_ALLOC_CHUNK_NUM_BITS - 1) / FIXED_ALLOC_CHUNK_NUM_BITS;
 }
 
-static void
-FIXED_ALLOC_NS(uninit_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+
+/*
+ * returns offset of the elements payload from the cluster's start
+ */
+static inline size_t
+FIXED_ALLOC_NS(internal_get_payload_offset)(size_t chunk_count)
 {
-    FIXED_ALLOC_NS(internal_chunk_cluster) * c = allocator->cluster;
-    while (NULL != c)
-    {
-        FIXED_ALLOC_NS(internal_chunk_cluster) * prev = c->prev;
-        FIXED_ALLOC_XFREE(c);
-        c = prev;
-    }
+    const size_t masks_end = offsetof(FIXED_ALLOC_NS(internal_chunk_cluster), free_masks) +
+        (chunk_count + FIXED_ALLOC_NS(internal_get_full_mask_size)(chunk_count)) * sizeof(FIXED_ALLOC_NS(InternalMaskType));
+
+    return (masks_end + FIXED_ALLOC_PAYLOAD_ALIGNMENT - 1) / FIXED_ALLOC_PAYLOAD_ALIGNMENT * FIXED_ALLOC_PAYLOAD_ALIGNMENT;
 }
 
+/*
+ * returns size of the cluster in bytes
+ */
+static inline size_t
+FIXED_ALLOC_NS(internal_get_cluster_size)(size_t chunk_count)
+{
+    return FIXED_ALLOC_NS(internal_get_payload_offset)(chunk_count) +
+        chunk_count * FIXED_ALLOC_CHUNK_NUM_BITS * sizeof(FIXED_ALLOC_ELEMENT_TYPE);
+}
 
-static FIXED_ALLOC_ELEMENT_TYPE *
-FIXED_ALLOC_NS(internal_alloc_elem_from_chunk)(FIXED_ALLOC_NS(internal_chunk) * chunk)
+/*
+ * returns pointer to the free mask of the chunk given
+ */
+static inline FIXED_ALLOC_NS(InternalMaskType) *
+FIXED_ALLOC_NS(internal_get_free_mask)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster, size_t chunk_index)
 {
-    size_t i;
-    FIXED_ALLOC_NS(InternalMaskType) mask = 1;
+    return &cluster->free_masks[chunk_index];
+}
 
-    FIXED_ALLOC_ASSERT(chunk->free_mask != FIXED_ALLOC_MASK_TYPE_MAX);
-    
-    for (i = 0; i < FIXED_ALLOC_CHUNK_NUM_BITS; ++i)
-    {
-        if (0 == (chunk->free_mask & mask))
-        {
-            // mark place as busy
-            chunk->free_mask |= mask;
-            return &chunk->arr[i];
-        }
+/*
+ * returns pointer to the element with the index given within the chunk
+ */
+static inline FIXED_ALLOC_ELEMENT_TYPE *
+FIXED_ALLOC_NS(internal_get_elem)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster, size_t chunk_index, size_t arr_index)
+{
+    return &cluster->payload[chunk_index * FIXED_ALLOC_CHUNK_NUM_BITS + arr_index];
+}
 
-        mask = mask << 1;
-    }
+#else
 
-    FIXED_ALLOC_ASSERT(!"should never come here");
-    return 0;
+/*
+ * returns size of the cluster in bytes
+ */
+static inline size_t
+FIXED_ALLOC_NS(internal_get_cluster_size)(size_t chunk_count)
+{
+    return offsetof(FIXED_ALLOC_NS(internal_chunk_cluster), chunks) +
+        chunk_count * sizeof(FIXED_ALLOC_NS(internal_chunk)) +
+        FIXED_ALLOC_NS(internal_get_full_mask_size)(chunk_count) * sizeof(FIXED_ALLOC_NS(InternalMaskType));
 }
 
-static FIXED_ALLOC_ELEMENT_TYPE *
-FIXED_ALLOC_NS(internal_find_free_elem)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+static inline FIXED_ALLOC_NS(InternalMaskType) *
+FIXED_ALLOC_NS(internal_get_free_mask)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster, size_t chunk_index)
 {
-    for (; cluster != NULL; cluster = cluster->prev)
-    {
-        size_t i;
-        
-        for (i = cluster->nfc_index; i < FIXED_ALLOC_INITIAL_CHUNK_SIZE; ++ i)
-        {
-            FIXED_ALLOC_NS(internal_chunk) * chunk = &cluster->chunks[i];
-            if (chunk->free_mask != FIXED_ALLOC_MASK_TYPE_MAX)
-            {
-                // free chunk has been found!
-                FIXED_ALLOC_ELEMENT_TYPE * result = FIXED_ALLOC_NS(internal_alloc_elem_from_chunk)(chunk);
-                
-                // update `last free chunk index' for this block if
-                // it pointed for this block before
-                if (chunk->free_mask == FIXED_ALLOC_MASK_TYPE_MAX && cluster->nfc_index == i)
-                {
-                    cluster->nfc_index = i + 1;
-                }
-
-                return result;
-            }
-        }
-    }
+    return &cluster->chunks[chunk_index].free_mask;
+}
 
-    return NULL;
+static inline FIXED_ALLOC_ELEMENT_TYPE *
+FIXED_ALLOC_NS(internal_get_elem)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster, size_t chunk_index, size_t arr_index)
+{
+    return &cluster->chunks[chunk_index].arr[arr_index];
 }
 
-static FIXED_ALLOC_ELEMENT_TYPE *
-FIXED_ALLOC_NS(alloc_elem)(FIXED_ALLOC_NS(allocator) * allocator)
+#endif // FIXED_ALLOC_SEPARATE_MASKS
+
+static void
+FIXED_ALLOC_NS(init_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
 {
-    FIXED_ALLOC_ELEMENT_TYPE * result;
-    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster = allocator->cluster;
+    allocator->cluster = NULL;
+    allocator->free_cluster = NULL;
 
-    result = FIXED_ALLOC_NS(internal_find_free_elem)(cluster);
-    if (NULL == result)
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+    allocator->empty_clusters = 0;
+#endif
+
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    FIXED_ALLOC_ASSERT(FIXED_ALLOC_INITIAL_CHUNK_SIZE <= FIXED_ALLOC_MAX_CHUNK_SIZE);
+    allocator->next_chunk_count = FIXED_ALLOC_INITIAL_CHUNK_SIZE;
+#endif
+
+#ifdef FIXED_ALLOC_ALIGNED_CLUSTERS
     {
-        // need to allocate one another block (all the blocks busy)
-        size_t s = sizeof(FIXED_ALLOC_NS(internal_chunk_cluster)) +
-            (FIXED_ALLOC_INITIAL_CHUNK_SIZE - 1) * sizeof(FIXED_ALLOC_NS(internal_chunk));
-        FIXED_ALLOC_NS(internal_chunk_cluster) * new_cluster = FIXED_ALLOC_XMALLOC(s);
-        
-        memset(new_cluster, 0, s);
-        new_cluster->prev = cluster;
-        allocator->cluster = new_cluster;
+        // alignment shall fit the biggest cluster
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+        const size_t s = FIXED_ALLOC_NS(internal_get_cluster_size)(FIXED_ALLOC_MAX_CHUNK_SIZE);
+#else
+        const size_t s = FIXED_ALLOC_NS(internal_get_cluster_size)(FIXED_ALLOC_INITIAL_CHUNK_SIZE);
+#endif
+        size_t alignment = sizeof(void *);
+
+        while (alignment < s)
+        {
+            alignment = alignment << 1;
+        }
+
+        allocator->cluster_alignment = alignment;
+    }
+#endif
+
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+    allocator->free_region = NULL;
+    allocator->region_size = (allocator->cluster_alignment > FIXED_ALLOC_MMAP_REGION_SIZE ?
+        allocator->cluster_alignment : FIXED_ALLOC_MMAP_REGION_SIZE);
+#endif
+}
+
+/*
+ * puts cluster on top of the list of clusters with free elements
+ */
+static inline void
+FIXED_ALLOC_NS(internal_link_free_cluster)(FIXED_ALLOC_NS(allocator) * allocator,
+                                           FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+    cluster->prev_free = NULL;
+    cluster->next_free = allocator->free_cluster;
+
+    if (NULL != allocator->free_cluster)
+    {
+        allocator->free_cluster->prev_free = cluster;
+    }
+
+    allocator->free_cluster = cluster;
+}
+
+/*
+ * excludes cluster from the list of clusters with free elements
+ */
+static inline void
+FIXED_ALLOC_NS(internal_unlink_free_cluster)(FIXED_ALLOC_NS(allocator) * allocator,
+                                             FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+    if (NULL != cluster->prev_free)
+    {
+        cluster->prev_free->next_free = cluster->next_free;
+    }
+    else
+    {
+        FIXED_ALLOC_ASSERT(allocator->free_cluster == cluster);
+        allocator->free_cluster = cluster->next_free;
+    }
+
+    if (NULL != cluster->next_free)
+    {
+        cluster->next_free->prev_free = cluster->prev_free;
+    }
+
+    cluster->prev_free = cluster->next_free = NULL;
+}
+
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+
+/*
+ * maps new region aligned to its size, returns NULL on failure
+ */
+static FIXED_ALLOC_NS(internal_region) *
+FIXED_ALLOC_NS(internal_map_region)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    const size_t size = allocator->region_size;
+    FIXED_ALLOC_NS(internal_region) * region;
+    char * p;
+    size_t head;
+
+    // map twice as much as needed and unmap the unaligned head and tail
+#ifdef MAP_ANONYMOUS
+    p = mmap(NULL, 2 * size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#else
+    p = mmap(NULL, 2 * size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+#endif
+    if (MAP_FAILED == (void *)p)
+    {
+        return NULL;
+    }
+
+    head = (size - (((size_t)p) & (size - 1))) & (size - 1);
+    if (head > 0)
+    {
+        munmap(p, head);
+    }
+
+    munmap(p + head + size, size - head);
+    p += head;
+
+#ifdef MADV_HUGEPAGE
+    // it is just an advice, the region is backed by the regular pages if huge pages are not available
+    madvise(p, size, MADV_HUGEPAGE);
+#endif
+
+    region = FIXED_ALLOC_XMALLOC(sizeof(FIXED_ALLOC_NS(internal_region)));
+    region->base = p;
+    region->carved = 0;
+    region->used = 0;
+    region->free_slot = NULL;
+
+    return region;
+}
+
+static inline void
+FIXED_ALLOC_NS(internal_link_free_region)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_NS(internal_region) * region)
+{
+    region->prev = NULL;
+    region->next = allocator->free_region;
+
+    if (NULL != allocator->free_region)
+    {
+        allocator->free_region->prev = region;
+    }
+
+    allocator->free_region = region;
+}
+
+static inline void
+FIXED_ALLOC_NS(internal_unlink_free_region)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_NS(internal_region) * region)
+{
+    if (NULL != region->prev)
+    {
+        region->prev->next = region->next;
+    }
+    else
+    {
+        allocator->free_region = region->next;
+    }
+
+    if (NULL != region->next)
+    {
+        region->next->prev = region->prev;
+    }
+}
+
+/*
+ * takes the slot for the new cluster from the region that has free slots or from the newly mapped one,
+ * returns NULL if mmap fails
+ */
+static FIXED_ALLOC_NS(internal_chunk_cluster) *
+FIXED_ALLOC_NS(internal_map_cluster)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    const size_t slot_count = allocator->region_size / allocator->cluster_alignment;
+    FIXED_ALLOC_NS(internal_region) * region = allocator->free_region;
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster;
+
+    if (NULL == region)
+    {
+        region = FIXED_ALLOC_NS(internal_map_region)(allocator);
+        if (NULL == region)
+        {
+            return NULL;
+        }
+
+        FIXED_ALLOC_NS(internal_link_free_region)(allocator, region);
+    }
+
+    if (NULL != region->free_slot)
+    {
+        cluster = region->free_slot;
+        region->free_slot = *((void **)cluster);
+    }
+    else
+    {
+        cluster = (FIXED_ALLOC_NS(internal_chunk_cluster) *)(region->base + region->carved * allocator->cluster_alignment);
+        ++region->carved;
+    }
+
+    // exclude full region from the list of regions with free slots
+    if (++region->used == slot_count)
+    {
+        FIXED_ALLOC_NS(internal_unlink_free_region)(allocator, region);
+    }
+
+    cluster->region = region;
+    return cluster;
+}
+
+/*
+ * returns the cluster's slot to its region, unmaps the region once it has no clusters
+ */
+static void
+FIXED_ALLOC_NS(internal_unmap_cluster)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+    const size_t slot_count = allocator->region_size / allocator->cluster_alignment;
+    FIXED_ALLOC_NS(internal_region) * region = cluster->region;
+
+    // full region has free slot now
+    if (region->used == slot_count)
+    {
+        FIXED_ALLOC_NS(internal_link_free_region)(allocator, region);
+    }
+
+    if (0 == --region->used)
+    {
+        FIXED_ALLOC_NS(internal_unlink_free_region)(allocator, region);
+        munmap(region->base, allocator->region_size);
+        FIXED_ALLOC_XFREE(region);
+        return;
+    }
+
+    *((void **)cluster) = region->free_slot;
+    region->free_slot = cluster;
+}
+
+#endif // FIXED_ALLOC_MMAP_REGIONS
+
+/*
+ * marks all the elements of the cluster as free ones
+ */
+static void
+FIXED_ALLOC_NS(internal_reset_cluster)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+    const size_t chunk_count = cluster->chunk_count;
+    const size_t full_mask_size = FIXED_ALLOC_NS(internal_get_full_mask_size)(chunk_count);
+
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+    memset(cluster->free_masks, 0, chunk_count * sizeof(FIXED_ALLOC_NS(InternalMaskType)));
+#else
+    size_t i;
+
+    for (i = 0; i < chunk_count; ++i)
+    {
+        cluster->chunks[i].free_mask = 0;
+    }
+#endif
+
+    memset(cluster->full_mask, 0, full_mask_size * sizeof(FIXED_ALLOC_NS(InternalMaskType)));
+
+    // chunks beyond the end of the cluster are marked as full ones
+    if (0 != (chunk_count % FIXED_ALLOC_CHUNK_NUM_BITS))
+    {
+        cluster->full_mask[full_mask_size - 1] =
+            FIXED_ALLOC_MASK_TYPE_MAX << (chunk_count % FIXED_ALLOC_CHUNK_NUM_BITS);
+    }
+
+    cluster->used = 0;
+    cluster->nfc_index = 0;
+}
+
+/*
+ * allocates new zero-filled cluster and puts it on top of the allocator's clusters lists
+ */
+static FIXED_ALLOC_NS(internal_chunk_cluster) *
+FIXED_ALLOC_NS(internal_create_cluster)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    const size_t chunk_count = allocator->next_chunk_count;
+#else
+    const size_t chunk_count = FIXED_ALLOC_INITIAL_CHUNK_SIZE;
+#endif
+    const size_t s = FIXED_ALLOC_NS(internal_get_cluster_size)(chunk_count);
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster;
+
+#if !defined(FIXED_ALLOC_ALIGNED_CLUSTERS)
+    cluster = FIXED_ALLOC_XMALLOC(s);
+    memset(cluster, 0, s);
+#elif defined(FIXED_ALLOC_XMALLOC_ALIGNED)
+    cluster = FIXED_ALLOC_XMALLOC_ALIGNED(s, allocator->cluster_alignment);
+    memset(cluster, 0, s);
+#else
+    {
+        const size_t alignment = allocator->cluster_alignment;
+        void * origin;
+
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+        cluster = FIXED_ALLOC_NS(internal_map_cluster)(allocator);
+        if (NULL != cluster)
+        {
+            FIXED_ALLOC_NS(internal_region) * region = cluster->region;
+
+            memset(cluster, 0, s);
+            cluster->region = region;
+        }
+        else
+#endif
+        {
+            origin = FIXED_ALLOC_XMALLOC(s + alignment - 1);
+
+            cluster = (FIXED_ALLOC_NS(internal_chunk_cluster) *)((((size_t)origin) + alignment - 1) & ~(alignment - 1));
+            memset(cluster, 0, s);
+            cluster->origin = origin;
+        }
+    }
+#endif
+
+#ifdef FIXED_ALLOC_ALIGNED_CLUSTERS
+    FIXED_ALLOC_ASSERT(0 == (((size_t)cluster) & (allocator->cluster_alignment - 1)));
+#endif
+
+    cluster->chunk_count = chunk_count;
+
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+    cluster->full_mask = &cluster->free_masks[chunk_count];
+    cluster->payload = (FIXED_ALLOC_ELEMENT_TYPE *)((char *)cluster + FIXED_ALLOC_NS(internal_get_payload_offset)(chunk_count));
+#else
+    cluster->full_mask = (FIXED_ALLOC_NS(InternalMaskType) *)&cluster->chunks[chunk_count];
+#endif
+
+    FIXED_ALLOC_NS(internal_reset_cluster)(cluster);
+
+#ifdef FIXED_ALLOC_MAX_CHUNK_SIZE
+    // next cluster will be twice as big
+    if (chunk_count < FIXED_ALLOC_MAX_CHUNK_SIZE)
+    {
+        allocator->next_chunk_count = (2 * chunk_count < FIXED_ALLOC_MAX_CHUNK_SIZE ? 2 * chunk_count : FIXED_ALLOC_MAX_CHUNK_SIZE);
+    }
+#endif
+
+    cluster->prev = allocator->cluster;
+    if (NULL != allocator->cluster)
+    {
+        allocator->cluster->next = cluster;
+    }
+    allocator->cluster = cluster;
+
+    FIXED_ALLOC_NS(internal_link_free_cluster)(allocator, cluster);
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+    ++allocator->empty_clusters;
+#endif
+
+    return cluster;
+}
+
+/*
+ * releases memory occupied by the cluster
+ */
+static void
+FIXED_ALLOC_NS(internal_free_cluster)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+#ifndef FIXED_ALLOC_MMAP_REGIONS
+    // allocator is only needed to unmap the cluster
+    (void)allocator;
+#endif
+
+#if !defined(FIXED_ALLOC_ALIGNED_CLUSTERS)
+    FIXED_ALLOC_XFREE(cluster);
+#elif defined(FIXED_ALLOC_XMALLOC_ALIGNED)
+    FIXED_ALLOC_XFREE_ALIGNED(cluster);
+#else
+#ifdef FIXED_ALLOC_MMAP_REGIONS
+    if (NULL != cluster->region)
+    {
+        FIXED_ALLOC_NS(internal_unmap_cluster)(allocator, cluster);
+        return;
+    }
+#endif
+
+    FIXED_ALLOC_XFREE(cluster->origin);
+#endif
+}
+
+static void
+FIXED_ALLOC_NS(uninit_allocator)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    FIXED_ALLOC_NS(internal_chunk_cluster) * c = allocator->cluster;
+    while (NULL != c)
+    {
+        FIXED_ALLOC_NS(internal_chunk_cluster) * prev = c->prev;
+        FIXED_ALLOC_NS(internal_free_cluster)(allocator, c);
+        c = prev;
+    }
+}
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+
+/*
+ * excludes cluster that has no allocated elements from the allocator's lists and releases it
+ */
+static void
+FIXED_ALLOC_NS(internal_release_cluster)(FIXED_ALLOC_NS(allocator) * allocator,
+                                         FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+    FIXED_ALLOC_ASSERT(0 == cluster->used);
+
+    FIXED_ALLOC_NS(internal_unlink_free_cluster)(allocator, cluster);
+
+    if (NULL != cluster->prev)
+    {
+        cluster->prev->next = cluster->next;
+    }
+
+    if (NULL != cluster->next)
+    {
+        cluster->next->prev = cluster->prev;
+    }
+    else
+    {
+        FIXED_ALLOC_ASSERT(allocator->cluster == cluster);
+        allocator->cluster = cluster->prev;
+    }
+
+    FIXED_ALLOC_NS(internal_free_cluster)(allocator, cluster);
+}
+
+#endif // FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+
+/*
+ * returns index of the lowest zero bit in the mask given, mask shall not be all-ones
+ */
+static inline size_t
+FIXED_ALLOC_NS(internal_find_zero_bit)(FIXED_ALLOC_NS(InternalMaskType) mask)
+{
+    FIXED_ALLOC_ASSERT(mask != FIXED_ALLOC_MASK_TYPE_MAX);
+
+    return bitops_ctz(~mask);
+}
+
+/*
+ * returns index of the first chunk that has free elements, cluster shall not be full
+ */
+static size_t
+FIXED_ALLOC_NS(internal_find_free_chunk)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster)
+{
+    size_t w;
+    size_t i;
+
+    // cluster has at least one free element, so that the summary bitmap
+    // has at least one non-full chunk at or after the nearest free chunk index
+    for (w = cluster->nfc_index / FIXED_ALLOC_CHUNK_NUM_BITS; ; ++w)
+    {
+        FIXED_ALLOC_ASSERT(w < FIXED_ALLOC_NS(internal_get_full_mask_size)(cluster->chunk_count));
+
+        if (cluster->full_mask[w] != FIXED_ALLOC_MASK_TYPE_MAX)
+        {
+            break;
+        }
+    }
+
+    i = w * FIXED_ALLOC_CHUNK_NUM_BITS + FIXED_ALLOC_NS(internal_find_zero_bit)(cluster->full_mask[w]);
+    FIXED_ALLOC_ASSERT(i < cluster->chunk_count);
+
+    // chunks before this one are known to be full
+    cluster->nfc_index = i;
+    return i;
+}
+
+/*
+ * updates cluster's counters and summary bitmap after count elements were taken from the chunk given
+ */
+static inline void
+FIXED_ALLOC_NS(internal_note_allocated)(FIXED_ALLOC_NS(allocator) * allocator,
+                                        FIXED_ALLOC_NS(internal_chunk_cluster) * cluster,
+                                        size_t chunk_index, size_t count)
+{
+    if (*FIXED_ALLOC_NS(internal_get_free_mask)(cluster, chunk_index) == FIXED_ALLOC_MASK_TYPE_MAX)
+    {
+        cluster->full_mask[chunk_index / FIXED_ALLOC_CHUNK_NUM_BITS] |=
+            ((FIXED_ALLOC_NS(InternalMaskType))1) << (chunk_index % FIXED_ALLOC_CHUNK_NUM_BITS);
+    }
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+    if (0 == cluster->used)
+    {
+        --allocator->empty_clusters;
+    }
+#endif
+
+    // exclude full cluster from the list of clusters with free elements
+    cluster->used += count;
+    if (cluster->used == cluster->chunk_count * FIXED_ALLOC_CHUNK_NUM_BITS)
+    {
+        FIXED_ALLOC_NS(internal_unlink_free_cluster)(allocator, cluster);
+    }
+}
+
+#ifndef FIXED_ALLOC_BATCH_ONLY
+
+static FIXED_ALLOC_ELEMENT_TYPE *
+FIXED_ALLOC_NS(internal_alloc_elem_from_chunk)(FIXED_ALLOC_NS(internal_chunk_cluster) * cluster, size_t chunk_index)
+{
+    FIXED_ALLOC_NS(InternalMaskType) * free_mask = FIXED_ALLOC_NS(internal_get_free_mask)(cluster, chunk_index);
+    size_t i = FIXED_ALLOC_NS(internal_find_zero_bit)(*free_mask);
+
+    // mark place as busy
+    *free_mask |= ((FIXED_ALLOC_NS(InternalMaskType))1) << i;
+    return FIXED_ALLOC_NS(internal_get_elem)(cluster, chunk_index, i);
+}
+
+static FIXED_ALLOC_ELEMENT_TYPE *
+FIXED_ALLOC_NS(internal_find_free_elem)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster = allocator->free_cluster;
+    FIXED_ALLOC_ELEMENT_TYPE * result;
+    size_t i;
+
+    if (NULL == cluster)
+    {
+        return NULL;
+    }
+
+    i = FIXED_ALLOC_NS(internal_find_free_chunk)(cluster);
+    result = FIXED_ALLOC_NS(internal_alloc_elem_from_chunk)(cluster, i);
+    FIXED_ALLOC_NS(internal_note_allocated)(allocator, cluster, i, 1);
+
+    return result;
+}
+
+static FIXED_ALLOC_ELEMENT_TYPE *
+FIXED_ALLOC_NS(alloc_elem)(FIXED_ALLOC_NS(allocator) * allocator)
+{
+    FIXED_ALLOC_ELEMENT_TYPE * result;
+
+    result = FIXED_ALLOC_NS(internal_find_free_elem)(allocator);
+    if (NULL == result)
+    {
+        // need to allocate one another block (all the blocks busy)
+        FIXED_ALLOC_NS(internal_create_cluster)(allocator);
 
         // since new block is allocated - the following function must succeed
-        result = FIXED_ALLOC_NS(internal_find_free_elem)(new_cluster);
+        result = FIXED_ALLOC_NS(internal_find_free_elem)(allocator);
         FIXED_ALLOC_ASSERT(result != 0);
     }
 
     return result;
 }
 
+#endif // FIXED_ALLOC_BATCH_ONLY
+
 /*
- * removes one element
+ * finds cluster the given element belongs to
  */
-static void
-FIXED_ALLOC_NS(free_elem)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELEMENT_TYPE * elem)
+static inline FIXED_ALLOC_NS(internal_chunk_cluster) *
+FIXED_ALLOC_NS(internal_find_cluster)(FIXED_ALLOC_NS(allocator) * allocator, const void * p)
 {
-    const void *    p = elem;
+#ifdef FIXED_ALLOC_ALIGNED_CLUSTERS
+    // cluster starts at the aligned address that precedes the element
+    return (FIXED_ALLOC_NS(internal_chunk_cluster) *)(((size_t)p) & ~(allocator->cluster_alignment - 1));
+#else
     FIXED_ALLOC_NS(internal_chunk_cluster) * cluster = allocator->cluster;
-    FIXED_ALLOC_NS(internal_chunk) * chunk;
-    size_t          chunk_index;
-    size_t          arr_index;
 
-    // find block the given list belongs to
     for (; cluster != NULL; cluster = cluster->prev)
     {
         void * left = cluster;
-        void * right = (char *)cluster + sizeof(FIXED_ALLOC_NS(internal_chunk_cluster)) +
-            (FIXED_ALLOC_INITIAL_CHUNK_SIZE - 1) * sizeof(FIXED_ALLOC_NS(internal_chunk));
+        void * right = (char *)cluster + FIXED_ALLOC_NS(internal_get_cluster_size)(cluster->chunk_count);
         
         if ((p > left) && (p < right))
         {
@@ -384,53 +1310,234 @@ FIXED_ALLOC_NS(free_elem)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELE
         }
     }
 
+    return cluster;
+#endif
+}
+
+/*
+ * finds cluster, chunk and index in the chunk of the given element
+ */
+static inline FIXED_ALLOC_NS(internal_chunk_cluster) *
+FIXED_ALLOC_NS(internal_locate_elem)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELEMENT_TYPE * elem,
+                                     size_t * chunk_index_p, size_t * arr_index_p)
+{
+    const void *    p = elem;
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster;
+    size_t          chunk_index;
+    size_t          arr_index;
+
+    // find block the given list belongs to
+    cluster = FIXED_ALLOC_NS(internal_find_cluster)(allocator, p);
+
     // block may not be null and list address shall not be less than the first one chunk entry
-    FIXED_ALLOC_ASSERT((NULL != cluster) && (p >= (const void *)&cluster->chunks[0].arr[0]));
+    FIXED_ALLOC_ASSERT((NULL != cluster) && (p >= (const void *)FIXED_ALLOC_NS(internal_get_elem)(cluster, 0, 0)));
 
+#ifdef FIXED_ALLOC_SEPARATE_MASKS
+    // elements of all the chunks form the single array
+    arr_index = (size_t)p - (size_t)FIXED_ALLOC_NS(internal_get_elem)(cluster, 0, 0);
+    FIXED_ALLOC_ASSERT(0 == (arr_index % sizeof(FIXED_ALLOC_ELEMENT_TYPE)));
+
+    arr_index = arr_index / sizeof(FIXED_ALLOC_ELEMENT_TYPE);
+    chunk_index = arr_index / FIXED_ALLOC_CHUNK_NUM_BITS;
+    arr_index = arr_index % FIXED_ALLOC_CHUNK_NUM_BITS;
+    FIXED_ALLOC_ASSERT(chunk_index < cluster->chunk_count);
+#else
     // get chunk index
     chunk_index = (((size_t)p) - ((size_t)cluster->chunks)) / sizeof(FIXED_ALLOC_NS(internal_chunk));
-    FIXED_ALLOC_ASSERT(chunk_index < FIXED_ALLOC_INITIAL_CHUNK_SIZE);
-
-    chunk = &cluster->chunks[chunk_index];
+    FIXED_ALLOC_ASSERT(chunk_index < cluster->chunk_count);
 
     // now find offset in chunk arr
-    arr_index = (size_t)p - (size_t)chunk->arr;
+    arr_index = (size_t)p - (size_t)cluster->chunks[chunk_index].arr;
     FIXED_ALLOC_ASSERT(0 == (arr_index % sizeof(FIXED_ALLOC_ELEMENT_TYPE)));
 
     // calculate an exact index
     arr_index = arr_index / sizeof(FIXED_ALLOC_ELEMENT_TYPE);
     FIXED_ALLOC_ASSERT(arr_index < FIXED_ALLOC_CHUNK_NUM_BITS);
+#endif
 
     // so at last index found - re-check that
-    FIXED_ALLOC_ASSERT(chunk->arr + arr_index == elem);
+    FIXED_ALLOC_ASSERT(FIXED_ALLOC_NS(internal_get_elem)(cluster, chunk_index, arr_index) == elem);
 
-    // check that element is not released twice
-    FIXED_ALLOC_ASSERT((chunk->free_mask & (((FIXED_ALLOC_NS(InternalMaskType))1) << arr_index)) != 0);
+    *chunk_index_p = chunk_index;
+    *arr_index_p = arr_index;
+    return cluster;
+}
 
-    // mark this element as free
-    chunk->free_mask &= ~(((FIXED_ALLOC_NS(InternalMaskType))1) << arr_index);
+/*
+ * marks elements of the chunk given by the bits of the mask as free ones
+ */
+static void
+FIXED_ALLOC_NS(internal_free_chunk_bits)(FIXED_ALLOC_NS(allocator) * allocator,
+                                         FIXED_ALLOC_NS(internal_chunk_cluster) * cluster,
+                                         size_t chunk_index, FIXED_ALLOC_NS(InternalMaskType) bits)
+{
+    FIXED_ALLOC_NS(InternalMaskType) * free_mask = FIXED_ALLOC_NS(internal_get_free_mask)(cluster, chunk_index);
+
+    // check that elements are not released twice
+    FIXED_ALLOC_ASSERT((*free_mask & bits) == bits);
+
+    // chunk is not full anymore
+    if (*free_mask == FIXED_ALLOC_MASK_TYPE_MAX)
+    {
+        cluster->full_mask[chunk_index / FIXED_ALLOC_CHUNK_NUM_BITS] &=
+            ~(((FIXED_ALLOC_NS(InternalMaskType))1) << (chunk_index % FIXED_ALLOC_CHUNK_NUM_BITS));
+    }
+
+    // return full cluster to the list of clusters with free elements
+    if (cluster->used == cluster->chunk_count * FIXED_ALLOC_CHUNK_NUM_BITS)
+    {
+        FIXED_ALLOC_NS(internal_link_free_cluster)(allocator, cluster);
+    }
+
+    cluster->used -= bitops_popcount(bits);
+
+    // mark these elements as free
+    *free_mask &= ~bits;
 
     // update last free chunk index if it is needed
     if (cluster->nfc_index > chunk_index)
     {
         cluster->nfc_index = chunk_index;
     }
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+    // release empty cluster unless it is needed to keep the retained ones
+    if (0 == cluster->used)
+    {
+        if (allocator->empty_clusters < FIXED_ALLOC_RETAINED_EMPTY_CLUSTERS)
+        {
+            ++allocator->empty_clusters;
+        }
+        else
+        {
+            FIXED_ALLOC_NS(internal_release_cluster)(allocator, cluster);
+        }
+    }
+#endif
 }
 
-#ifdef FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#ifndef FIXED_ALLOC_BATCH_ONLY
 
-static size_t
-FIXED_ALLOC_NS(internal_get_bits_count)(FIXED_ALLOC_NS(InternalMaskType) num)
+/*
+ * removes one element
+ */
+static inline void
+FIXED_ALLOC_NS(free_elem)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELEMENT_TYPE * elem)
 {
-    size_t  result = 0;
-    size_t  i;
-    for (i = 0; i < FIXED_ALLOC_CHUNK_NUM_BITS; ++ i)
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster;
+    size_t          chunk_index;
+    size_t          arr_index;
+
+    cluster = FIXED_ALLOC_NS(internal_locate_elem)(allocator, elem, &chunk_index, &arr_index);
+    FIXED_ALLOC_NS(internal_free_chunk_bits)(allocator, cluster, chunk_index,
+        ((FIXED_ALLOC_NS(InternalMaskType))1) << arr_index);
+}
+
+#endif // FIXED_ALLOC_BATCH_ONLY
+
+#ifdef FIXED_ALLOC_BATCH_REQUIRED
+
+/*
+ * allocates n elements and puts them to the given array,
+ * all the free elements of the chunk are taken at once by setting its free mask
+ */
+static void
+FIXED_ALLOC_NS(alloc_elem_n)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELEMENT_TYPE ** elems, size_t n)
+{
+    while (n > 0)
     {
-        result += (num & 1);
-        num = num >> 1;
+        FIXED_ALLOC_NS(internal_chunk_cluster) * cluster = allocator->free_cluster;
+        FIXED_ALLOC_NS(InternalMaskType) * free_mask;
+        FIXED_ALLOC_NS(InternalMaskType) bits;
+        size_t chunk_index;
+        size_t count;
+
+        if (NULL == cluster)
+        {
+            cluster = FIXED_ALLOC_NS(internal_create_cluster)(allocator);
+        }
+
+        chunk_index = FIXED_ALLOC_NS(internal_find_free_chunk)(cluster);
+        free_mask = FIXED_ALLOC_NS(internal_get_free_mask)(cluster, chunk_index);
+
+        // free elements of the chunk
+        bits = ~*free_mask;
+        count = bitops_popcount(bits);
+
+        if (count > n)
+        {
+            // take the n lowest ones
+            FIXED_ALLOC_NS(InternalMaskType) rest = bits;
+
+            for (count = 0; count < n; ++count)
+            {
+                rest &= rest - 1;
+            }
+
+            bits &= ~rest;
+        }
+
+        *free_mask |= bits;
+        FIXED_ALLOC_NS(internal_note_allocated)(allocator, cluster, chunk_index, count);
+        n -= count;
+
+        for (; bits != 0; bits &= bits - 1)
+        {
+            *elems++ = FIXED_ALLOC_NS(internal_get_elem)(cluster, chunk_index, bitops_ctz(bits));
+        }
     }
+}
 
-    return result;
+/*
+ * disposes n elements given by the array,
+ * free mask of the chunk is updated once for the adjacent elements of the same chunk
+ */
+static void
+FIXED_ALLOC_NS(free_elem_n)(FIXED_ALLOC_NS(allocator) * allocator, FIXED_ALLOC_ELEMENT_TYPE ** elems, size_t n)
+{
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster = NULL;
+    FIXED_ALLOC_NS(InternalMaskType) bits = 0;
+    size_t chunk_index = 0;
+    size_t i;
+
+    for (i = 0; i < n; ++i)
+    {
+        size_t elem_chunk_index;
+        size_t arr_index;
+        FIXED_ALLOC_NS(internal_chunk_cluster) * elem_cluster =
+            FIXED_ALLOC_NS(internal_locate_elem)(allocator, elems[i], &elem_chunk_index, &arr_index);
+
+        if ((elem_cluster != cluster) || (elem_chunk_index != chunk_index))
+        {
+            if (0 != bits)
+            {
+                FIXED_ALLOC_NS(internal_free_chunk_bits)(allocator, cluster, chunk_index, bits);
+            }
+
+            cluster = elem_cluster;
+            chunk_index = elem_chunk_index;
+            bits = 0;
+        }
+
+        // check that element is not listed twice
+        FIXED_ALLOC_ASSERT(0 == (bits & (((FIXED_ALLOC_NS(InternalMaskType))1) << arr_index)));
+        bits |= ((FIXED_ALLOC_NS(InternalMaskType))1) << arr_index;
+    }
+
+    if (0 != bits)
+    {
+        FIXED_ALLOC_NS(internal_free_chunk_bits)(allocator, cluster, chunk_index, bits);
+    }
+}
+
+#endif // FIXED_ALLOC_BATCH_REQUIRED
+
+#ifdef FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+
+static inline size_t
+FIXED_ALLOC_NS(internal_get_bits_count)(FIXED_ALLOC_NS(InternalMaskType) num)
+{
+    return bitops_popcount(num);
 }
 
 static void
@@ -443,13 +1550,13 @@ FIXED_ALLOC_NS(get_allocator_status)(FIXED_ALLOC_NS(allocator) * allocator, size
 
     for (cluster = allocator->cluster; NULL != cluster; cluster = cluster->prev)
     {
-        int i;
+        size_t i;
 
-        *allocated += FIXED_ALLOC_CHUNK_NUM_BITS * FIXED_ALLOC_INITIAL_CHUNK_SIZE;
+        *allocated += FIXED_ALLOC_CHUNK_NUM_BITS * cluster->chunk_count;
 
-        for (i = 0; i < FIXED_ALLOC_INITIAL_CHUNK_SIZE; ++ i)
+        for (i = 0; i < cluster->chunk_count; ++ i)
         {
-            *used += FIXED_ALLOC_NS(internal_get_bits_count)(cluster->chunks[i].free_mask);
+            *used += FIXED_ALLOC_NS(internal_get_bits_count)(*FIXED_ALLOC_NS(internal_get_free_mask)(cluster, i));
         }
     }
 }
@@ -467,24 +1574,15 @@ FIXED_ALLOC_NS(allocator_foreach)(FIXED_ALLOC_NS(allocator) * allocator, void *
     {
         size_t i;
 
-        for (i = 0; i < FIXED_ALLOC_INITIAL_CHUNK_SIZE; ++ i)
+        for (i = 0; i < cluster->chunk_count; ++ i)
         {
-            FIXED_ALLOC_NS(internal_chunk) * chunk = &cluster->chunks[i];
+            FIXED_ALLOC_NS(InternalMaskType) mask = *FIXED_ALLOC_NS(internal_get_free_mask)(cluster, i);
 
-            if (chunk->free_mask != 0)
+            // visit allocated elements only, lowest set bit is dropped on each step
+            while (0 != mask)
             {
-                FIXED_ALLOC_NS(InternalMaskType) mask = 1;
-                size_t j;
-
-                for (j = 0; j < FIXED_ALLOC_CHUNK_NUM_BITS; ++j)
-                {
-                    if (chunk->free_mask & mask)
-                    {
-                        foreach_callback(context, &chunk->arr[j]);
-                    }
-
-                    mask = mask << 1;
-                }
+                foreach_callback(context, FIXED_ALLOC_NS(internal_get_elem)(cluster, i, bitops_ctz(mask)));
+                mask &= mask - 1;
             }
         }
     }
@@ -492,19 +1590,70 @@ FIXED_ALLOC_NS(allocator_foreach)(FIXED_ALLOC_NS(allocator) * allocator, void *
 
 #endif // FIXED_ALLOC_FOREACH_REQUIRED
 
-#endif // FIXED_ALLOC_FREE_FUNCTION_REQUIRED
-
 #ifdef FIXED_ALLOC_CLEAR_REQUIRED
 
 static void
 FIXED_ALLOC_NS(allocator_clear)(FIXED_ALLOC_NS(allocator) * allocator)
 {
-    FIXED_ALLOC_NS(allocator_uninit)(allocator);
-    FIXED_ALLOC_NS(allocator_init)(allocator);
-}
+    FIXED_ALLOC_NS(internal_chunk_cluster) * cluster = allocator->cluster;
+    FIXED_ALLOC_NS(internal_chunk_cluster) * last = NULL;
+#ifdef FIXED_ALLOC_CLEAR_RETAINED_SIZE
+    size_t retained = 0;
+#endif
+
+    allocator->free_cluster = NULL;
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+    allocator->empty_clusters = 0;
+#endif
 
+    // make all the kept clusters empty ones
+    for (; NULL != cluster; cluster = cluster->prev)
+    {
+#ifdef FIXED_ALLOC_CLEAR_RETAINED_SIZE
+        if (retained >= FIXED_ALLOC_CLEAR_RETAINED_SIZE)
+        {
+            break;
+        }
+
+        retained += cluster->chunk_count * FIXED_ALLOC_CHUNK_NUM_BITS;
 #endif
 
+        FIXED_ALLOC_NS(internal_reset_cluster)(cluster);
+        FIXED_ALLOC_NS(internal_link_free_cluster)(allocator, cluster);
+
+#ifdef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+        ++allocator->empty_clusters;
+#endif
+
+        last = cluster;
+    }
+
+    // release the rest of the clusters
+    if (NULL != cluster)
+    {
+        if (NULL != last)
+        {
+            last->prev = NULL;
+        }
+        else
+        {
+            allocator->cluster = NULL;
+        }
+
+        while (NULL != cluster)
+        {
+            FIXED_ALLOC_NS(internal_chunk_cluster) * prev = cluster->prev;
+            FIXED_ALLOC_NS(internal_free_cluster)(allocator, cluster);
+            cluster = prev;
+        }
+    }
+}
+
+#endif // FIXED_ALLOC_CLEAR_REQUIRED
+
+#endif // FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+
 /*
  * undefine user macros
  */
@@ -516,6 +1665,19 @@ FIXED_ALLOC_NS(allocator_clear)(FIXED_ALLOC_NS(allocator) * allocator)
 #undef FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
 #undef FIXED_ALLOC_INITIAL_CHUNK_SIZE
 #undef FIXED_ALLOC_CHUNK_NUM_BITS
+#undef FIXED_ALLOC_MAX_CHUNK_SIZE
 #undef FIXED_ALLOC_ASSERT
 #undef FIXED_ALLOC_FOREACH_REQUIRED
 #undef FIXED_ALLOC_CLEAR_REQUIRED
+#undef FIXED_ALLOC_CLEAR_RETAINED_SIZE
+#undef FIXED_ALLOC_BATCH_REQUIRED
+#undef FIXED_ALLOC_BATCH_ONLY
+#undef FIXED_ALLOC_ALIGNED_CLUSTERS
+#undef FIXED_ALLOC_XMALLOC_ALIGNED
+#undef FIXED_ALLOC_XFREE_ALIGNED
+#undef FIXED_ALLOC_SEPARATE_MASKS
+#undef FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#undef FIXED_ALLOC_RETAINED_EMPTY_CLUSTERS
+#undef FIXED_ALLOC_PAYLOAD_ALIGNMENT
+#undef FIXED_ALLOC_MMAP_REGIONS
+#undef FIXED_ALLOC_MMAP_REGION_SIZE
@@ -0,0 +1,184 @@
+/*
+ * template implementation of the interpolation search algorithm over the sorted array of arithmetic keys.
+ *
+ * the position of the key is estimated by the linear interpolation between the first and the last
+ * element of the search range, what takes O(log log N) probes for the uniformly distributed keys,
+ * such as timestamps or sequential identifiers.
+ * the range is bisected in addition to the interpolation step if the latter has not halved the range,
+ * so each step halves the range at least and the search takes O(log N) steps whatever the distribution is.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  INTERPOLATION_SEARCH_ARRAY_TYPE - defines array type
+ *  INTERPOLATION_SEARCH_KEY_TYPE - defines arithmetic key type which index is to be searched in an array
+ *  INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) - returns key of an array's element at the given position,
+ *                                                   the array is ordered by the built-in comparison operators
+ *                                                   applied to these keys
+ *
+ * optional macros:
+ *  INTERPOLATION_SEARCH_NS - namespace macro
+ *
+ * unmasked types/functions:
+ *  interpolation_lower_bound   returns index of the first element that is not less than the key
+ *  interpolation_search        returns index of the element that is equal to the key
+ */
+
+/*
+ sample usage:
+
+    // define type names
+    #define INTERPOLATION_SEARCH_NS(name)       ts_##name
+    #define INTERPOLATION_SEARCH_ARRAY_TYPE     const struct Event *
+    #define INTERPOLATION_SEARCH_KEY_TYPE       int64_t
+    #define INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) (array[index].timestamp)
+
+    #include <templates/interpolation_search.h>
+
+    ...
+    first = ts_interpolation_lower_bound(events, count, since);
+ */
+
+#include <stddef.h>
+#include <float.h>
+
+#ifndef INTERPOLATION_SEARCH_NS
+#define INTERPOLATION_SEARCH_NS(name) name
+#endif
+
+#ifndef INTERPOLATION_SEARCH_ARRAY_TYPE
+#error INTERPOLATION_SEARCH_ARRAY_TYPE is not defined
+#endif
+
+#ifndef INTERPOLATION_SEARCH_KEY_TYPE
+#error INTERPOLATION_SEARCH_KEY_TYPE is not defined
+#endif
+
+#ifndef INTERPOLATION_SEARCH_ELEMENT_KEY
+#error INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) is not defined
+#endif
+
+
+/**
+ * finds the first element of the sorted array that is not less than the key given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns size_t      index of the found element or count if all the elements are less than the key
+ */
+static size_t
+INTERPOLATION_SEARCH_NS(interpolation_lower_bound)(INTERPOLATION_SEARCH_ARRAY_TYPE array, size_t count,
+                                                   INTERPOLATION_SEARCH_KEY_TYPE key)
+{
+    // the elements before begin are less than the key, the elements starting from end are not
+    size_t begin = 0;
+    size_t end = count;
+
+    while (begin < end)
+    {
+        size_t size = end - begin;
+        INTERPOLATION_SEARCH_KEY_TYPE low = INTERPOLATION_SEARCH_ELEMENT_KEY(array, begin);
+        INTERPOLATION_SEARCH_KEY_TYPE high = INTERPOLATION_SEARCH_ELEMENT_KEY(array, end - 1);
+        size_t position;
+        double span;
+        double ratio;
+
+        if (!(low < key))
+        {
+            return begin;
+        }
+
+        if (high < key)
+        {
+            return end;
+        }
+
+        // low < key <= high here, but the distinct wide keys may be equal once converted to double
+        span = (double)high - (double)low;
+        if ((span > 0.0) && (span <= DBL_MAX))
+        {
+            ratio = ((double)key - (double)low) / span;
+            if (!(ratio >= 0.0))
+            {
+                ratio = 0.0;
+            }
+            else if (ratio > 1.0)
+            {
+                ratio = 1.0;
+            }
+
+            position = begin + (size_t)((double)(end - 1 - begin) * ratio);
+        }
+        else
+        {
+            position = begin + (end - 1 - begin) / 2;
+        }
+
+        if (position >= end)
+        {
+            position = end - 1;
+        }
+
+        if (INTERPOLATION_SEARCH_ELEMENT_KEY(array, position) < key)
+        {
+            begin = position + 1;
+        }
+        else
+        {
+            end = position;
+        }
+
+        // the estimation was poor, so the rest of the range is bisected
+        if (end - begin > size / 2)
+        {
+            position = begin + (end - begin) / 2;
+
+            if (INTERPOLATION_SEARCH_ELEMENT_KEY(array, position) < key)
+            {
+                begin = position + 1;
+            }
+            else
+            {
+                end = position;
+            }
+        }
+    }
+
+    return begin;
+}
+
+/**
+ * performs interpolation search over the array given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns ptrdiff_t   non-negative index of the first corresponding array element
+ *                      if such exists, or negative value that represents
+ *                      binary negation of the target index
+ *                      before what the source element is to be inserted
+ */
+static inline ptrdiff_t
+INTERPOLATION_SEARCH_NS(interpolation_search)(INTERPOLATION_SEARCH_ARRAY_TYPE array, size_t count,
+                                              INTERPOLATION_SEARCH_KEY_TYPE key)
+{
+    size_t index = INTERPOLATION_SEARCH_NS(interpolation_lower_bound)(array, count, key);
+
+    if ((index < count) && (INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) == key))
+    {
+        return (ptrdiff_t)index;
+    }
+
+    return ~(ptrdiff_t)index;
+}
+
+
+/*
+ * undefine user macros
+ */
+#undef INTERPOLATION_SEARCH_NS
+#undef INTERPOLATION_SEARCH_ARRAY_TYPE
+#undef INTERPOLATION_SEARCH_KEY_TYPE
+#undef INTERPOLATION_SEARCH_ELEMENT_KEY
@@ -0,0 +1,347 @@
+/*
+ * template implementation of the lock-free stack (Treiber stack) shared between threads.
+ *
+ * the stack's nodes are taken from the pool of chunks that grow geometrically, the same way as
+ * fixed_alloc does, and are never returned to the system until the stack is uninitialized.
+ * nodes are addressed by 32-bit indices, so the top of the stack is a 64-bit word that holds the index
+ * of the top node along with the tag that is incremented by each modification, what protects
+ * compare-and-swap operations from the ABA problem.
+ * the disposed nodes are kept in the lock-free stack of free nodes of the same kind.
+ *
+ * the implementation relies on C11 atomics.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  LF_STACK_ELEMENT_TYPE - defines element type
+ *  LF_STACK_XMALLOC - defines memory allocation function, that never returns 0
+ *  LF_STACK_XFREE - defines memory releasing function
+ *
+ * optional macros:
+ *  LF_STACK_NS - namespace macro
+ *  LF_STACK_ASSERT - specifies user-level assert macro
+ *  LF_STACK_INITIAL_CHUNK_SIZE - count of nodes in the first chunk of the pool, each next chunk is twice
+ *                                larger up to 2^24 nodes, 256 by default, the pool consists of 255 chunks at most
+ *
+ * unmasked types/functions:
+ *  lf_stack                stack structure, shared between threads
+ *  lf_stack_init           initializes stack
+ *  lf_stack_uninit         uninitializes stack, shall not be called concurrently with the other functions
+ *  lf_stack_push           pushes the given element to the stack, fails if the pool of nodes is exhausted
+ *  lf_stack_pop            pops last element from the stack if it is not empty
+ *  lf_stack_empty          returns true if stack is empty at the moment, false otherwise
+ *
+ *  internal_node           internally used node structure
+ *  internal_get_node       internal function
+ *  internal_push_nodes     internal function
+ *  internal_pop_node       internal function
+ *  internal_alloc_node     internal function
+ */
+
+/*
+ sample usage:
+
+    // define type names
+    #define LF_STACK_NS(n)              task_##n
+    #define LF_STACK_ELEMENT_TYPE       struct Task *
+    #define LF_STACK_XMALLOC            xmalloc
+    #define LF_STACK_XFREE              xfree
+
+    #include <templates/lf_stack.h>
+
+    ...
+    task_lf_stack   tasks;      // shared one
+    struct Task *   task;
+
+    task_lf_stack_init(&tasks);
+
+    // in any thread
+    task_lf_stack_push(&tasks, task);
+
+    // in any thread
+    while (task_lf_stack_pop(&tasks, &task))
+    {
+        ...
+    }
+
+    task_lf_stack_uninit(&tasks);
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifndef LF_STACK_NS
+#define LF_STACK_NS(name) name
+#endif
+
+#ifndef LF_STACK_ELEMENT_TYPE
+#error LF_STACK_ELEMENT_TYPE is not defined
+#endif
+
+#ifndef LF_STACK_XMALLOC
+#error LF_STACK_XMALLOC is not been defined
+#endif
+
+#ifndef LF_STACK_XFREE
+#error LF_STACK_XFREE is not been defined
+#endif
+
+#ifndef LF_STACK_ASSERT
+#include <assert.h>
+#define LF_STACK_ASSERT(x) assert(x)
+#endif
+
+#ifndef LF_STACK_INITIAL_CHUNK_SIZE
+#define LF_STACK_INITIAL_CHUNK_SIZE  (256)
+#endif
+
+#ifndef LF_STACK_INTERNAL_DEFINED
+#define LF_STACK_INTERNAL_DEFINED
+
+/* node index is composed of the chunk index and the offset of the node in the chunk */
+#define LF_STACK_INTERNAL_OFFSET_BITS   (24)
+#define LF_STACK_INTERNAL_OFFSET_MASK   ((1U << LF_STACK_INTERNAL_OFFSET_BITS) - 1)
+
+/* the last node of the chunk with the highest index would be the same as LF_STACK_INTERNAL_NIL */
+#define LF_STACK_INTERNAL_MAX_CHUNKS    ((1U << (32 - LF_STACK_INTERNAL_OFFSET_BITS)) - 1)
+
+/* index that refers to no node */
+#define LF_STACK_INTERNAL_NIL           (0xFFFFFFFFU)
+
+/* composes the top of the stack from the tag and the node index */
+#define LF_STACK_INTERNAL_TOP(tag, index) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+
+#endif /* LF_STACK_INTERNAL_DEFINED */
+
+
+/**
+ * node of the stack
+ */
+typedef struct
+{
+    LF_STACK_ELEMENT_TYPE       element;
+    _Atomic uint32_t            next;
+} LF_STACK_NS(internal_node);
+
+/**
+ * stack data structure
+ */
+typedef struct
+{
+    /* tagged index of the top node */
+    _Atomic uint64_t            top;
+
+    /* tagged index of the top free node */
+    _Atomic uint64_t            free_top;
+
+    /* count of chunks which slots are reserved, the chunk is set before any of its nodes is published,
+     * it never exceeds LF_STACK_INTERNAL_MAX_CHUNKS */
+    _Atomic uint32_t            chunk_count;
+
+    LF_STACK_NS(internal_node) * chunks[LF_STACK_INTERNAL_MAX_CHUNKS];
+} LF_STACK_NS(lf_stack);
+
+
+/**
+ * returns node by its index
+ */
+static inline LF_STACK_NS(internal_node) * LF_STACK_NS(internal_get_node)(LF_STACK_NS(lf_stack) * stack, uint32_t index)
+{
+    LF_STACK_ASSERT((index >> LF_STACK_INTERNAL_OFFSET_BITS) < LF_STACK_INTERNAL_MAX_CHUNKS);
+    return &stack->chunks[index >> LF_STACK_INTERNAL_OFFSET_BITS][index & LF_STACK_INTERNAL_OFFSET_MASK];
+}
+
+/**
+ * pushes the chain of the linked nodes to the given list
+ * \param top       tagged top of the list
+ * \param first     index of the first node of the chain, it becomes the top of the list
+ * \param last      the last node of the chain
+ */
+static void LF_STACK_NS(internal_push_nodes)(_Atomic uint64_t * top, uint32_t first, LF_STACK_NS(internal_node) * last)
+{
+    uint64_t old_top = atomic_load_explicit(top, memory_order_relaxed);
+    uint64_t new_top;
+
+    do
+    {
+        atomic_store_explicit(&last->next, (uint32_t)old_top, memory_order_relaxed);
+        new_top = LF_STACK_INTERNAL_TOP((old_top >> 32) + 1, first);
+    }
+    while (!atomic_compare_exchange_weak_explicit(top, &old_top, new_top, memory_order_release, memory_order_relaxed));
+}
+
+/**
+ * pops the node from the given list
+ * \param stack     stack which nodes are popped
+ * \param top       tagged top of the list
+ * \return index of the popped node or LF_STACK_INTERNAL_NIL if the list is empty
+ */
+static uint32_t LF_STACK_NS(internal_pop_node)(LF_STACK_NS(lf_stack) * stack, _Atomic uint64_t * top)
+{
+    uint64_t old_top = atomic_load_explicit(top, memory_order_acquire);
+    uint64_t new_top;
+    uint32_t index;
+
+    do
+    {
+        index = (uint32_t)old_top;
+        if (LF_STACK_INTERNAL_NIL == index)
+        {
+            break;
+        }
+
+        /* the node might be popped concurrently, its memory is still valid and the tag makes CAS fail then */
+        new_top = LF_STACK_INTERNAL_TOP((old_top >> 32) + 1,
+                                        atomic_load_explicit(&LF_STACK_NS(internal_get_node)(stack, index)->next,
+                                                             memory_order_relaxed));
+    }
+    while (!atomic_compare_exchange_weak_explicit(top, &old_top, new_top, memory_order_acquire, memory_order_acquire));
+
+    return index;
+}
+
+/**
+ * allocates new node, the new chunk is added to the pool if there are no free nodes
+ * \param stack     source stack
+ * \return index of the allocated node or LF_STACK_INTERNAL_NIL if all the chunks are in use
+ */
+static uint32_t LF_STACK_NS(internal_alloc_node)(LF_STACK_NS(lf_stack) * stack)
+{
+    uint32_t index = LF_STACK_NS(internal_pop_node)(stack, &stack->free_top);
+    uint32_t chunk_index;
+    size_t chunk_size;
+    size_t i;
+    LF_STACK_NS(internal_node) * chunk;
+
+    if (LF_STACK_INTERNAL_NIL != index)
+    {
+        return index;
+    }
+
+    /* concurrent threads may add chunks at the same time, the extra nodes are kept as free ones */
+    chunk_index = atomic_load_explicit(&stack->chunk_count, memory_order_relaxed);
+    do
+    {
+        if (chunk_index >= LF_STACK_INTERNAL_MAX_CHUNKS)
+        {
+            return LF_STACK_INTERNAL_NIL;
+        }
+    }
+    while (!atomic_compare_exchange_weak_explicit(&stack->chunk_count, &chunk_index, chunk_index + 1,
+                                                  memory_order_relaxed, memory_order_relaxed));
+
+    chunk_size = (size_t)LF_STACK_INITIAL_CHUNK_SIZE << (chunk_index < 24 ? chunk_index : 24);
+    if (chunk_size > (size_t)LF_STACK_INTERNAL_OFFSET_MASK + 1)
+    {
+        chunk_size = (size_t)LF_STACK_INTERNAL_OFFSET_MASK + 1;
+    }
+
+    chunk = LF_STACK_XMALLOC(chunk_size * sizeof(LF_STACK_NS(internal_node)));
+    stack->chunks[chunk_index] = chunk;
+
+    index = chunk_index << LF_STACK_INTERNAL_OFFSET_BITS;
+    if (chunk_size > 1)
+    {
+        /* the first node is returned, the rest ones are published as free ones */
+        for (i = 1; i < chunk_size - 1; ++i)
+        {
+            atomic_init(&chunk[i].next, index + (uint32_t)i + 1);
+        }
+
+        LF_STACK_NS(internal_push_nodes)(&stack->free_top, index + 1, &chunk[chunk_size - 1]);
+    }
+
+    return index;
+}
+
+/**
+ * initializes the given stack
+ */
+static void LF_STACK_NS(lf_stack_init)(LF_STACK_NS(lf_stack) * stack)
+{
+    atomic_init(&stack->top, LF_STACK_INTERNAL_TOP(0, LF_STACK_INTERNAL_NIL));
+    atomic_init(&stack->free_top, LF_STACK_INTERNAL_TOP(0, LF_STACK_INTERNAL_NIL));
+    atomic_init(&stack->chunk_count, 0);
+}
+
+/**
+ * uninitializes the given stack, elements that remain in the stack are discarded
+ */
+static void LF_STACK_NS(lf_stack_uninit)(LF_STACK_NS(lf_stack) * stack)
+{
+    uint32_t chunk_count = atomic_load_explicit(&stack->chunk_count, memory_order_acquire);
+    uint32_t i;
+
+    for (i = 0; i < chunk_count; ++i)
+    {
+        LF_STACK_XFREE(stack->chunks[i]);
+    }
+}
+
+/**
+ * pushes the given element to the stack
+ * \param stack     destination stack
+ * \param element   source element
+ * \return true if the element has been pushed, false if the pool of nodes is exhausted
+ */
+static bool LF_STACK_NS(lf_stack_push)(LF_STACK_NS(lf_stack) * stack, LF_STACK_ELEMENT_TYPE element)
+{
+    uint32_t index = LF_STACK_NS(internal_alloc_node)(stack);
+    LF_STACK_NS(internal_node) * node;
+
+    if (LF_STACK_INTERNAL_NIL == index)
+    {
+        return false;
+    }
+
+    node = LF_STACK_NS(internal_get_node)(stack, index);
+    node->element = element;
+    LF_STACK_NS(internal_push_nodes)(&stack->top, index, node);
+    return true;
+}
+
+/**
+ * pops the last element from the stack
+ * \param stack     source stack
+ * \param element   destination, receives the popped element
+ * \return true if the element has been popped, false if the stack is empty
+ */
+static bool LF_STACK_NS(lf_stack_pop)(LF_STACK_NS(lf_stack) * stack, LF_STACK_ELEMENT_TYPE * element)
+{
+    uint32_t index = LF_STACK_NS(internal_pop_node)(stack, &stack->top);
+    LF_STACK_NS(internal_node) * node;
+
+    if (LF_STACK_INTERNAL_NIL == index)
+    {
+        return false;
+    }
+
+    node = LF_STACK_NS(internal_get_node)(stack, index);
+    *element = node->element;
+
+    LF_STACK_NS(internal_push_nodes)(&stack->free_top, index, node);
+    return true;
+}
+
+/**
+ * returns true if the given stack is empty, the result may be outdated if the stack is modified concurrently
+ */
+static inline bool LF_STACK_NS(lf_stack_empty)(LF_STACK_NS(lf_stack) * stack)
+{
+    return LF_STACK_INTERNAL_NIL == (uint32_t)atomic_load_explicit(&stack->top, memory_order_acquire);
+}
+
+/*
+ * undefine user macros
+ */
+#undef LF_STACK_ELEMENT_TYPE
+#undef LF_STACK_XMALLOC
+#undef LF_STACK_XFREE
+#undef LF_STACK_NS
+#undef LF_STACK_ASSERT
+#undef LF_STACK_INITIAL_CHUNK_SIZE
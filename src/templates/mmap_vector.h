@@ -0,0 +1,429 @@
+/*
+ * template implementation of the vector which storage is a memory-mapped file.
+ *
+ * the file starts with the header that holds the vector's size and the size of its element,
+ * the elements follow the header, so the vector is opened without reading its contents.
+ * the file grows geometrically by means of ftruncate and mremap (or by remapping the file where
+ * mremap is not declared, e.g. when _GNU_SOURCE is not defined on linux), the elements are written
+ * directly to the mapped pages.
+ * the elements shall be plain data that does not refer to the memory of the process.
+ *
+ * the implementation relies on POSIX file and memory mapping functions.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  MMAP_VECTOR_ELEMENT_TYPE - defines element type
+ *
+ * optional macros:
+ *  MMAP_VECTOR_NS - namespace macro
+ *  MMAP_VECTOR_ASSERT - specifies user-level assert macro
+ *  MMAP_VECTOR_GROW_SIZE - specifies count of elements the new file is able to hold, the file grows
+ *                          twice each time when it is exhausted, 1024 by default
+ *  MMAP_VECTOR_CLEAR_REQUIRED - specifies whether mmap_vector_clear function is required
+ *
+ * unmasked types/functions:
+ *  mmap_vector                 vector structure
+ *  mmap_vector_open            opens or creates the vector stored in the given file
+ *  mmap_vector_close           unmaps the vector and closes its file
+ *  mmap_vector_sync            writes the vector's changes to the file
+ *  mmap_vector_push_back       pushes back element to certain vector
+ *  mmap_vector_emplace_back    appends uninitialized element to the vector and returns pointer to it
+ *  mmap_vector_append_n        copies the given range of elements to the end of the vector
+ *  mmap_vector_reserve         makes vector capable to hold the given count of elements without remapping
+ *  mmap_vector_data            returns pointer to the vector's data
+ *  mmap_vector_size            returns size of the vector
+ *  mmap_vector_clear           empties vector's contents, the file is not truncated
+ *
+ *  internal_header             internally used file header structure
+ *  internal_get_length         internal function
+ *  internal_map                internal function
+ *  internal_set_capacity       internal function
+ *  internal_grow               internal function
+ */
+
+/*
+ sample usage:
+
+    // define type names
+    #define MMAP_VECTOR_NS(n)           rec_##n
+    #define MMAP_VECTOR_ELEMENT_TYPE    struct Record
+
+    #include <templates/mmap_vector.h>
+
+    ...
+    rec_mmap_vector     records;
+
+    if (!rec_mmap_vector_open(&records, "records.dat"))
+    {
+        // errno describes the error
+    }
+
+    rec_mmap_vector_push_back(&records, record);
+    rec_mmap_vector_sync(&records);
+    rec_mmap_vector_close(&records);
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef MMAP_VECTOR_NS
+#define MMAP_VECTOR_NS(name) name
+#endif
+
+#ifndef MMAP_VECTOR_ELEMENT_TYPE
+#error MMAP_VECTOR_ELEMENT_TYPE is not defined
+#endif
+
+#ifndef MMAP_VECTOR_ASSERT
+#include <assert.h>
+#define MMAP_VECTOR_ASSERT(x) assert(x)
+#endif
+
+#ifndef MMAP_VECTOR_GROW_SIZE
+#define MMAP_VECTOR_GROW_SIZE  (1024)
+#endif
+
+#ifndef MMAP_VECTOR_INTERNAL_DEFINED
+#define MMAP_VECTOR_INTERNAL_DEFINED
+
+/* identifies the vector's file, "ctvector" read as little endian number */
+#define MMAP_VECTOR_INTERNAL_MAGIC          (0x726f746365767463ULL)
+
+/* space occupied by the file header, the elements start at this offset */
+#define MMAP_VECTOR_INTERNAL_HEADER_SIZE    (64)
+
+#endif /* MMAP_VECTOR_INTERNAL_DEFINED */
+
+
+/**
+ * defines header of the vector's file
+ */
+typedef struct
+{
+    uint64_t                    magic;
+    uint64_t                    element_size;
+    uint64_t                    size;
+} MMAP_VECTOR_NS(internal_header);
+
+/**
+ * defines vector structure
+ */
+typedef struct
+{
+    int                                 fd;
+    MMAP_VECTOR_NS(internal_header) *   header;
+    MMAP_VECTOR_ELEMENT_TYPE *          elements;
+
+    size_t                              length;
+    size_t                              allocated;
+} MMAP_VECTOR_NS(mmap_vector);
+
+
+/**
+ * returns length of the file that is able to hold the given count of elements, the length is page aligned
+ * \param capacity  count of elements
+ */
+static size_t MMAP_VECTOR_NS(internal_get_length)(size_t capacity)
+{
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t length = MMAP_VECTOR_INTERNAL_HEADER_SIZE + capacity * sizeof(MMAP_VECTOR_ELEMENT_TYPE);
+
+    return (length + page_size - 1) / page_size * page_size;
+}
+
+/**
+ * maps the vector's file of the given length
+ * \param vector    source vector
+ * \param length    length of the file
+ * \return true if the file has been mapped
+ */
+static bool MMAP_VECTOR_NS(internal_map)(MMAP_VECTOR_NS(mmap_vector) * vector, size_t length)
+{
+    void * p = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, vector->fd, 0);
+
+    if (MAP_FAILED == p)
+    {
+        return false;
+    }
+
+    vector->header = p;
+    vector->elements = (MMAP_VECTOR_ELEMENT_TYPE *)((char *)p + MMAP_VECTOR_INTERNAL_HEADER_SIZE);
+    vector->length = length;
+    vector->allocated = (length - MMAP_VECTOR_INTERNAL_HEADER_SIZE) / sizeof(MMAP_VECTOR_ELEMENT_TYPE);
+    return true;
+}
+
+/**
+ * opens the vector stored in the given file, the file is created if it does not exist or empty
+ * \param vector    vector to be initialized
+ * \param path      path to the vector's file
+ * \return true if the vector has been opened, false otherwise, errno specifies the error then
+ */
+static bool MMAP_VECTOR_NS(mmap_vector_open)(MMAP_VECTOR_NS(mmap_vector) * vector, const char * path)
+{
+    struct stat st;
+    int error = EINVAL;
+
+    vector->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (vector->fd < 0)
+    {
+        return false;
+    }
+
+    if (0 != fstat(vector->fd, &st))
+    {
+        error = errno;
+    }
+    else if (0 == st.st_size)
+    {
+        /* new vector */
+        const size_t length = MMAP_VECTOR_NS(internal_get_length)(MMAP_VECTOR_GROW_SIZE);
+
+        if ((0 == ftruncate(vector->fd, (off_t)length)) && MMAP_VECTOR_NS(internal_map)(vector, length))
+        {
+            vector->header->magic = MMAP_VECTOR_INTERNAL_MAGIC;
+            vector->header->element_size = sizeof(MMAP_VECTOR_ELEMENT_TYPE);
+            vector->header->size = 0;
+            return true;
+        }
+
+        error = errno;
+    }
+    else if ((size_t)st.st_size >= MMAP_VECTOR_INTERNAL_HEADER_SIZE + sizeof(MMAP_VECTOR_ELEMENT_TYPE))
+    {
+        /* existing vector, only the header is verified */
+        if (!MMAP_VECTOR_NS(internal_map)(vector, (size_t)st.st_size))
+        {
+            error = errno;
+        }
+        else if ((MMAP_VECTOR_INTERNAL_MAGIC == vector->header->magic) &&
+                 (sizeof(MMAP_VECTOR_ELEMENT_TYPE) == vector->header->element_size) &&
+                 (vector->header->size <= vector->allocated))
+        {
+            return true;
+        }
+        else
+        {
+            munmap(vector->header, vector->length);
+        }
+    }
+
+    close(vector->fd);
+    errno = error;
+    return false;
+}
+
+/**
+ * unmaps the vector and closes its file, the changes are written to the file by the system,
+ * use mmap_vector_sync to make sure they reached the storage
+ * \param vector    vector to be closed
+ */
+static inline void MMAP_VECTOR_NS(mmap_vector_close)(MMAP_VECTOR_NS(mmap_vector) * vector)
+{
+    munmap(vector->header, vector->length);
+    close(vector->fd);
+}
+
+/**
+ * synchronously writes the vector's changes to the file
+ * \param vector    source vector
+ * \return true if the changes have been written
+ */
+static inline bool MMAP_VECTOR_NS(mmap_vector_sync)(MMAP_VECTOR_NS(mmap_vector) * vector)
+{
+    return 0 == msync(vector->header, vector->length, MS_SYNC);
+}
+
+/**
+ * grows the vector's file and remaps it
+ * \param vector    source vector
+ * \param capacity  new count of elements the vector is able to hold
+ * \return true if the vector has been grown
+ */
+static bool MMAP_VECTOR_NS(internal_set_capacity)(MMAP_VECTOR_NS(mmap_vector) * vector, size_t capacity)
+{
+    const size_t length = MMAP_VECTOR_NS(internal_get_length)(capacity);
+#ifndef MREMAP_MAYMOVE
+    size_t old_length;
+#endif
+    void * p;
+
+    MMAP_VECTOR_ASSERT(length > vector->length);
+
+    if (0 != ftruncate(vector->fd, (off_t)length))
+    {
+        return false;
+    }
+
+#ifdef MREMAP_MAYMOVE
+    p = mremap(vector->header, vector->length, length, MREMAP_MAYMOVE);
+    if (MAP_FAILED == p)
+    {
+        return false;
+    }
+
+    vector->header = p;
+    vector->elements = (MMAP_VECTOR_ELEMENT_TYPE *)((char *)p + MMAP_VECTOR_INTERNAL_HEADER_SIZE);
+    vector->length = length;
+    vector->allocated = (length - MMAP_VECTOR_INTERNAL_HEADER_SIZE) / sizeof(MMAP_VECTOR_ELEMENT_TYPE);
+    return true;
+#else
+    /* the file contents are kept by the system, so the file is just mapped again */
+    p = vector->header;
+    old_length = vector->length;
+    if (!MMAP_VECTOR_NS(internal_map)(vector, length))
+    {
+        return false;
+    }
+
+    munmap(p, old_length);
+    return true;
+#endif
+}
+
+/**
+ * grows the vector twice or up to the required size if it is greater
+ * \param vector    source vector
+ * \param required  count of elements the vector shall be able to hold
+ * \return true if the vector has been grown
+ */
+static bool MMAP_VECTOR_NS(internal_grow)(MMAP_VECTOR_NS(mmap_vector) * vector, size_t required)
+{
+    size_t capacity = 2 * vector->allocated;
+
+    if (capacity < required)
+    {
+        capacity = required;
+    }
+
+    return MMAP_VECTOR_NS(internal_set_capacity)(vector, capacity);
+}
+
+/**
+ * returns a pointer to the vector's data, it remains valid until the vector is grown
+ * \param vector    source vector
+ * \return pointer to the elements array
+ */
+static inline MMAP_VECTOR_ELEMENT_TYPE * MMAP_VECTOR_NS(mmap_vector_data)(MMAP_VECTOR_NS(mmap_vector) * vector)
+{
+    return vector->elements;
+}
+
+/**
+ * returns size of the vector
+ * \param vector    source vector
+ * \return size of the vector
+ */
+static inline size_t MMAP_VECTOR_NS(mmap_vector_size)(MMAP_VECTOR_NS(mmap_vector) * vector)
+{
+    return (size_t)vector->header->size;
+}
+
+/**
+ * appends uninitialized element to the end of the vector
+ * \param vector    source vector
+ * \return pointer to the appended element or NULL if the file can not be grown, errno specifies the error then
+ */
+static inline MMAP_VECTOR_ELEMENT_TYPE * MMAP_VECTOR_NS(mmap_vector_emplace_back)(MMAP_VECTOR_NS(mmap_vector) * vector)
+{
+    const size_t size = (size_t)vector->header->size;
+
+    if ((size == vector->allocated) && !MMAP_VECTOR_NS(internal_grow)(vector, size + 1))
+    {
+        return NULL;
+    }
+
+    vector->header->size = size + 1;
+    return vector->elements + size;
+}
+
+/**
+ * pushes the element provided back to the vector
+ * \param vector        source vector
+ * \param element       element to be pushed back
+ * \return true if the element has been pushed, false if the file can not be grown, errno specifies the error then
+ */
+static inline bool MMAP_VECTOR_NS(mmap_vector_push_back)(MMAP_VECTOR_NS(mmap_vector) * vector, MMAP_VECTOR_ELEMENT_TYPE element)
+{
+    const size_t size = (size_t)vector->header->size;
+
+    if ((size == vector->allocated) && !MMAP_VECTOR_NS(internal_grow)(vector, size + 1))
+    {
+        return false;
+    }
+
+    /* the element is written before the size, so the stored size never covers unwritten elements */
+    vector->elements[size] = element;
+    vector->header->size = size + 1;
+    return true;
+}
+
+/**
+ * copies the given range of elements to the end of the vector
+ * \param vector    source vector
+ * \param elements  elements to be copied, shall not point to the vector's own data
+ * \param count     count of elements
+ * \return true if the elements have been copied, false if the file can not be grown, errno specifies the error then
+ */
+static inline bool MMAP_VECTOR_NS(mmap_vector_append_n)(MMAP_VECTOR_NS(mmap_vector) * vector,
+                                                 const MMAP_VECTOR_ELEMENT_TYPE * elements, size_t count)
+{
+    const size_t size = (size_t)vector->header->size;
+
+    if (((size + count) > vector->allocated) && !MMAP_VECTOR_NS(internal_grow)(vector, size + count))
+    {
+        return false;
+    }
+
+    memcpy(vector->elements + size, elements, count * sizeof(MMAP_VECTOR_ELEMENT_TYPE));
+    vector->header->size = size + count;
+    return true;
+}
+
+/**
+ * makes the vector capable to hold the given count of elements without growing the file
+ * \param vector    source vector
+ * \param capacity  count of elements
+ * \return true if the vector is able to hold the given count of elements
+ */
+static inline bool MMAP_VECTOR_NS(mmap_vector_reserve)(MMAP_VECTOR_NS(mmap_vector) * vector, size_t capacity)
+{
+    if (capacity > vector->allocated)
+    {
+        return MMAP_VECTOR_NS(internal_set_capacity)(vector, capacity);
+    }
+
+    return true;
+}
+
+/**
+ * clears the vector's contents without truncating the file
+ * \param vector    source vector
+ */
+#ifdef MMAP_VECTOR_CLEAR_REQUIRED
+static inline void MMAP_VECTOR_NS(mmap_vector_clear)(MMAP_VECTOR_NS(mmap_vector) * vector)
+{
+    vector->header->size = 0;
+}
+#endif
+
+/*
+ * undefine user macros
+ */
+#undef MMAP_VECTOR_ELEMENT_TYPE
+#undef MMAP_VECTOR_NS
+#undef MMAP_VECTOR_ASSERT
+#undef MMAP_VECTOR_GROW_SIZE
+#undef MMAP_VECTOR_CLEAR_REQUIRED
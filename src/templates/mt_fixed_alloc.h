@@ -0,0 +1,455 @@
+/*
+ * template implementation of the fixed allocation mechanism that is shared between threads.
+ *
+ * every thread allocates and frees elements through its own cache, that holds two magazines - arrays of
+ * free elements, so most of the allocations and disposals do not take any lock.
+ * when both magazines of the cache are exhausted (or filled) the cache exchanges them with the shared depot
+ * of full and empty magazines, so elements freed by the other thread flow back in batches.
+ * the depot takes new elements from the underlying fixed allocator a magazine at a time.
+ *
+ * the implementation relies on POSIX threads.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  MT_FIXED_ALLOC_ELEMENT_TYPE - defines element type
+ *  MT_FIXED_ALLOC_XMALLOC - defines memory allocation function, that will never return 0
+ *  MT_FIXED_ALLOC_XFREE - defines memory releasing function
+ *
+ * optional macros:
+ *  MT_FIXED_ALLOC_NS - namespace macro
+ *  MT_FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED - if defined, get status function will be made available
+ *  MT_FIXED_ALLOC_INITIAL_CHUNK_SIZE - defines chunk size of the underlying fixed allocator
+ *  MT_FIXED_ALLOC_MAX_CHUNK_SIZE - defines max chunk size of the underlying fixed allocator
+ *  MT_FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS - specifies that the underlying fixed allocator returns unused memory to the system
+ *  MT_FIXED_ALLOC_MAGAZINE_SIZE - count of elements in the magazine, 64 by default
+ *  MT_FIXED_ALLOC_DEPOT_SIZE - max count of full magazines kept by depot, elements of the magazines beyond
+ *                              this count are returned back to the underlying allocator, 16 by default
+ *  MT_FIXED_ALLOC_ASSERT - specifies assertion
+ *
+ * unmasked types/functions:
+ *  allocator                       allocator structure, shared between threads
+ *  cache                           per-thread cache structure
+ *  init_allocator                  initializes allocator
+ *  uninit_allocator                uninitializes allocator, all the caches shall be uninitialized before
+ *  init_cache                      initializes the cache of the calling thread
+ *  uninit_cache                    returns elements held by the cache back to the allocator
+ *  alloc_elem                      allocates new element
+ *  free_elem                       disposes element given that was previously allocated by any cache of the allocator
+ *  get_allocator_status            retrieves allocator status, elements held by caches are considered as used ones
+ *
+ *  internal_magazine               internally used magazine structure
+ *  internal_pool_*                 internally used fixed allocator
+ *  internal_free_magazines         internal function
+ *  internal_get_magazine           internal function
+ *  internal_put_magazine           internal function
+ *  internal_drain_magazine         internal function
+ *  internal_reload                 internal function
+ *  internal_unload                 internal function
+ */
+
+/*
+ sample usage:
+
+    // define type names
+    #define MT_FIXED_ALLOC_NS(n)            int_##n
+    #define MT_FIXED_ALLOC_ELEMENT_TYPE     int
+    #define MT_FIXED_ALLOC_XMALLOC          xmalloc
+    #define MT_FIXED_ALLOC_XFREE            xfree
+
+    #include <templates/mt_fixed_alloc.h>
+
+    ...
+    int_allocator        intallocator;     // shared one
+
+    int_init_allocator(&intallocator);
+
+    // in each thread
+    {
+        int_cache   cache;
+        int *       num;
+
+        int_init_cache(&intallocator, &cache);
+
+        num = int_alloc_elem(&cache);
+        int_free_elem(&cache, num);
+
+        int_uninit_cache(&cache);
+    }
+
+    int_uninit_allocator(&intallocator);
+ */
+
+#include <pthread.h>
+
+
+/*
+ * name specifier that originates the name
+ */
+#ifndef MT_FIXED_ALLOC_NS
+#define MT_FIXED_ALLOC_NS(name) name
+#endif
+
+/*
+ * imported types
+ */
+
+#ifndef MT_FIXED_ALLOC_ELEMENT_TYPE
+#error MT_FIXED_ALLOC_ELEMENT_TYPE is not defined
+#endif
+
+/*
+ * imported functions
+ */
+
+#ifndef MT_FIXED_ALLOC_ASSERT
+#include <assert.h>
+#define MT_FIXED_ALLOC_ASSERT(condition) assert(condition)
+#endif
+
+#ifndef MT_FIXED_ALLOC_XMALLOC
+#error MT_FIXED_ALLOC_XMALLOC is not defined
+#endif
+
+#ifndef MT_FIXED_ALLOC_XFREE
+#error MT_FIXED_ALLOC_XFREE is not defined
+#endif
+
+/*
+ * magazines sizes
+ */
+
+#ifndef MT_FIXED_ALLOC_MAGAZINE_SIZE
+#define MT_FIXED_ALLOC_MAGAZINE_SIZE    (64)
+#endif
+
+#ifndef MT_FIXED_ALLOC_DEPOT_SIZE
+#define MT_FIXED_ALLOC_DEPOT_SIZE       (16)
+#endif
+
+/*
+ * instantiate underlying allocator
+ */
+#define MT_FIXED_ALLOC_POOL_NS(name)    MT_FIXED_ALLOC_NS(internal_pool_##name)
+
+#define FIXED_ALLOC_NS(name)            MT_FIXED_ALLOC_POOL_NS(name)
+#define FIXED_ALLOC_ELEMENT_TYPE        MT_FIXED_ALLOC_ELEMENT_TYPE
+#define FIXED_ALLOC_XMALLOC             MT_FIXED_ALLOC_XMALLOC
+#define FIXED_ALLOC_XFREE               MT_FIXED_ALLOC_XFREE
+#define FIXED_ALLOC_ASSERT              MT_FIXED_ALLOC_ASSERT
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_BATCH_REQUIRED
+#define FIXED_ALLOC_BATCH_ONLY
+
+#ifdef MT_FIXED_ALLOC_INITIAL_CHUNK_SIZE
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE  MT_FIXED_ALLOC_INITIAL_CHUNK_SIZE
+#endif
+
+#ifdef MT_FIXED_ALLOC_MAX_CHUNK_SIZE
+#define FIXED_ALLOC_MAX_CHUNK_SIZE      MT_FIXED_ALLOC_MAX_CHUNK_SIZE
+#endif
+
+#ifdef MT_FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#endif
+
+#ifdef MT_FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#endif
+
+#include "fixed_alloc.h"
+
+/*
+ * array of free elements
+ */
+typedef struct MT_FIXED_ALLOC_NS(internal_magazine)
+{
+    /*
+     * next magazine in the depot's list
+     */
+    struct MT_FIXED_ALLOC_NS(internal_magazine) *   next;
+
+    /*
+     * count of elements in the magazine
+     */
+    size_t                                          count;
+
+    MT_FIXED_ALLOC_ELEMENT_TYPE *                   rounds[MT_FIXED_ALLOC_MAGAZINE_SIZE];
+} MT_FIXED_ALLOC_NS(internal_magazine);
+
+typedef struct MT_FIXED_ALLOC_NS(allocator)
+{
+    /*
+     * guards the depot and the underlying allocator
+     */
+    pthread_mutex_t                                 lock;
+
+    MT_FIXED_ALLOC_POOL_NS(allocator)               pool;
+
+    /*
+     * depot: lists of full and empty magazines
+     */
+    MT_FIXED_ALLOC_NS(internal_magazine) *          full;
+    size_t                                          full_count;
+    MT_FIXED_ALLOC_NS(internal_magazine) *          empty;
+} MT_FIXED_ALLOC_NS(allocator);
+
+typedef struct MT_FIXED_ALLOC_NS(cache)
+{
+    MT_FIXED_ALLOC_NS(allocator) *                  allocator;
+
+    /*
+     * magazine elements are allocated from and freed to
+     */
+    MT_FIXED_ALLOC_NS(internal_magazine) *          loaded;
+
+    /*
+     * magazine that is swapped with the loaded one when the latter is exhausted or filled
+     */
+    MT_FIXED_ALLOC_NS(internal_magazine) *          previous;
+} MT_FIXED_ALLOC_NS(cache);
+
+
+static void
+MT_FIXED_ALLOC_NS(init_allocator)(MT_FIXED_ALLOC_NS(allocator) * allocator)
+{
+    pthread_mutex_init(&allocator->lock, NULL);
+    MT_FIXED_ALLOC_POOL_NS(init_allocator)(&allocator->pool);
+    allocator->full = NULL;
+    allocator->full_count = 0;
+    allocator->empty = NULL;
+}
+
+static void
+MT_FIXED_ALLOC_NS(internal_free_magazines)(MT_FIXED_ALLOC_NS(internal_magazine) * m)
+{
+    while (NULL != m)
+    {
+        MT_FIXED_ALLOC_NS(internal_magazine) * next = m->next;
+        MT_FIXED_ALLOC_XFREE(m);
+        m = next;
+    }
+}
+
+static void
+MT_FIXED_ALLOC_NS(uninit_allocator)(MT_FIXED_ALLOC_NS(allocator) * allocator)
+{
+    // elements of the full magazines are released along with the pool
+    MT_FIXED_ALLOC_NS(internal_free_magazines)(allocator->full);
+    MT_FIXED_ALLOC_NS(internal_free_magazines)(allocator->empty);
+    MT_FIXED_ALLOC_POOL_NS(uninit_allocator)(&allocator->pool);
+    pthread_mutex_destroy(&allocator->lock);
+}
+
+/*
+ * returns empty magazine taken from depot or newly allocated one, shall be called under lock
+ */
+static MT_FIXED_ALLOC_NS(internal_magazine) *
+MT_FIXED_ALLOC_NS(internal_get_magazine)(MT_FIXED_ALLOC_NS(allocator) * allocator)
+{
+    MT_FIXED_ALLOC_NS(internal_magazine) * m = allocator->empty;
+
+    if (NULL != m)
+    {
+        allocator->empty = m->next;
+    }
+    else
+    {
+        m = MT_FIXED_ALLOC_XMALLOC(sizeof(MT_FIXED_ALLOC_NS(internal_magazine)));
+    }
+
+    m->next = NULL;
+    m->count = 0;
+    return m;
+}
+
+/*
+ * puts empty magazine to depot, shall be called under lock
+ */
+static void
+MT_FIXED_ALLOC_NS(internal_put_magazine)(MT_FIXED_ALLOC_NS(allocator) * allocator, MT_FIXED_ALLOC_NS(internal_magazine) * m)
+{
+    MT_FIXED_ALLOC_ASSERT(m->count == 0);
+    m->next = allocator->empty;
+    allocator->empty = m;
+}
+
+/*
+ * returns all the elements of the magazine to the underlying allocator, shall be called under lock
+ */
+static void
+MT_FIXED_ALLOC_NS(internal_drain_magazine)(MT_FIXED_ALLOC_NS(allocator) * allocator, MT_FIXED_ALLOC_NS(internal_magazine) * m)
+{
+    MT_FIXED_ALLOC_POOL_NS(free_elem_n)(&allocator->pool, m->rounds, m->count);
+    m->count = 0;
+}
+
+static void
+MT_FIXED_ALLOC_NS(init_cache)(MT_FIXED_ALLOC_NS(allocator) * allocator, MT_FIXED_ALLOC_NS(cache) * cache)
+{
+    cache->allocator = allocator;
+
+    pthread_mutex_lock(&allocator->lock);
+    cache->loaded = MT_FIXED_ALLOC_NS(internal_get_magazine)(allocator);
+    cache->previous = MT_FIXED_ALLOC_NS(internal_get_magazine)(allocator);
+    pthread_mutex_unlock(&allocator->lock);
+}
+
+static void
+MT_FIXED_ALLOC_NS(uninit_cache)(MT_FIXED_ALLOC_NS(cache) * cache)
+{
+    MT_FIXED_ALLOC_NS(allocator) * allocator = cache->allocator;
+
+    pthread_mutex_lock(&allocator->lock);
+    MT_FIXED_ALLOC_NS(internal_drain_magazine)(allocator, cache->loaded);
+    MT_FIXED_ALLOC_NS(internal_put_magazine)(allocator, cache->loaded);
+    MT_FIXED_ALLOC_NS(internal_drain_magazine)(allocator, cache->previous);
+    MT_FIXED_ALLOC_NS(internal_put_magazine)(allocator, cache->previous);
+    pthread_mutex_unlock(&allocator->lock);
+
+    cache->loaded = cache->previous = NULL;
+}
+
+/*
+ * replaces the cache's empty magazines with the full one from depot or fills the loaded magazine
+ * with the elements from the underlying allocator
+ */
+static void
+MT_FIXED_ALLOC_NS(internal_reload)(MT_FIXED_ALLOC_NS(cache) * cache)
+{
+    MT_FIXED_ALLOC_NS(allocator) * allocator = cache->allocator;
+    MT_FIXED_ALLOC_NS(internal_magazine) * m = cache->loaded;
+
+    MT_FIXED_ALLOC_ASSERT(m->count == 0);
+
+    pthread_mutex_lock(&allocator->lock);
+
+    if (NULL != allocator->full)
+    {
+        MT_FIXED_ALLOC_NS(internal_put_magazine)(allocator, m);
+
+        cache->loaded = allocator->full;
+        allocator->full = allocator->full->next;
+        --allocator->full_count;
+    }
+    else
+    {
+        MT_FIXED_ALLOC_POOL_NS(alloc_elem_n)(&allocator->pool, m->rounds, MT_FIXED_ALLOC_MAGAZINE_SIZE);
+        m->count = MT_FIXED_ALLOC_MAGAZINE_SIZE;
+    }
+
+    pthread_mutex_unlock(&allocator->lock);
+}
+
+/*
+ * passes the cache's full magazine to depot and provides the cache with the empty one
+ */
+static void
+MT_FIXED_ALLOC_NS(internal_unload)(MT_FIXED_ALLOC_NS(cache) * cache)
+{
+    MT_FIXED_ALLOC_NS(allocator) * allocator = cache->allocator;
+    MT_FIXED_ALLOC_NS(internal_magazine) * m = cache->previous;
+
+    MT_FIXED_ALLOC_ASSERT(m->count == MT_FIXED_ALLOC_MAGAZINE_SIZE);
+
+    pthread_mutex_lock(&allocator->lock);
+
+    if (allocator->full_count < MT_FIXED_ALLOC_DEPOT_SIZE)
+    {
+        m->next = allocator->full;
+        allocator->full = m;
+        ++allocator->full_count;
+
+        cache->previous = cache->loaded;
+        cache->loaded = MT_FIXED_ALLOC_NS(internal_get_magazine)(allocator);
+    }
+    else
+    {
+        // depot is full, return the elements to the underlying allocator
+        MT_FIXED_ALLOC_NS(internal_drain_magazine)(allocator, m);
+
+        cache->previous = cache->loaded;
+        cache->loaded = m;
+    }
+
+    pthread_mutex_unlock(&allocator->lock);
+}
+
+static MT_FIXED_ALLOC_ELEMENT_TYPE *
+MT_FIXED_ALLOC_NS(alloc_elem)(MT_FIXED_ALLOC_NS(cache) * cache)
+{
+    MT_FIXED_ALLOC_NS(internal_magazine) * m = cache->loaded;
+
+    if (m->count == 0)
+    {
+        if (cache->previous->count > 0)
+        {
+            cache->loaded = cache->previous;
+            cache->previous = m;
+        }
+        else
+        {
+            MT_FIXED_ALLOC_NS(internal_reload)(cache);
+        }
+
+        m = cache->loaded;
+    }
+
+    return m->rounds[--m->count];
+}
+
+static void
+MT_FIXED_ALLOC_NS(free_elem)(MT_FIXED_ALLOC_NS(cache) * cache, MT_FIXED_ALLOC_ELEMENT_TYPE * p)
+{
+    MT_FIXED_ALLOC_NS(internal_magazine) * m = cache->loaded;
+
+    if (m->count == MT_FIXED_ALLOC_MAGAZINE_SIZE)
+    {
+        if (cache->previous->count == 0)
+        {
+            cache->loaded = cache->previous;
+            cache->previous = m;
+        }
+        else
+        {
+            MT_FIXED_ALLOC_NS(internal_unload)(cache);
+        }
+
+        m = cache->loaded;
+    }
+
+    m->rounds[m->count++] = p;
+}
+
+#ifdef MT_FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+
+static void
+MT_FIXED_ALLOC_NS(get_allocator_status)(MT_FIXED_ALLOC_NS(allocator) * allocator, size_t * used, size_t * allocated)
+{
+    pthread_mutex_lock(&allocator->lock);
+    MT_FIXED_ALLOC_POOL_NS(get_allocator_status)(&allocator->pool, used, allocated);
+    *used -= allocator->full_count * MT_FIXED_ALLOC_MAGAZINE_SIZE;
+    pthread_mutex_unlock(&allocator->lock);
+}
+
+#endif // MT_FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+
+/*
+ * undefine user macros
+ */
+#undef MT_FIXED_ALLOC_ELEMENT_TYPE
+#undef MT_FIXED_ALLOC_XMALLOC
+#undef MT_FIXED_ALLOC_XFREE
+#undef MT_FIXED_ALLOC_NS
+#undef MT_FIXED_ALLOC_POOL_NS
+#undef MT_FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#undef MT_FIXED_ALLOC_INITIAL_CHUNK_SIZE
+#undef MT_FIXED_ALLOC_MAX_CHUNK_SIZE
+#undef MT_FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#undef MT_FIXED_ALLOC_MAGAZINE_SIZE
+#undef MT_FIXED_ALLOC_DEPOT_SIZE
+#undef MT_FIXED_ALLOC_ASSERT
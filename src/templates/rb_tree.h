@@ -22,10 +22,19 @@
  *  RB_TREE_PRINT_NODE - print macro, that shall be defined to make print_tree function work
  *  RB_TREE_IS_VALID_TREE_REQUIRED - specifies, that is_tree_valid function is required
  *  RB_TREE_INITIAL_CHUNK_SIZE - defines initial chunk size in bytes for internally used nodes allocator
+ *  RB_TREE_MAX_CHUNK_SIZE - if defined, nodes allocator doubles chunk size on each allocation up to this value
+ *  RB_TREE_RELEASE_EMPTY_CLUSTERS - specifies that nodes allocator returns unused memory to the system after nodes removal
+ *  RB_TREE_XMALLOC_ALIGNED(size, alignment) - aligned allocation function for the nodes allocator clusters,
+ *                     it takes effect only if RB_TREE_REMOVE_NODE_REQUIRED is defined
+ *  RB_TREE_XFREE_ALIGNED - memory releasing function for the RB_TREE_XMALLOC_ALIGNED
+ *  RB_TREE_MMAP_REGIONS - specifies that nodes allocator maps its memory with mmap in large regions backed by huge pages
+ *                     where available, it takes effect only if RB_TREE_REMOVE_NODE_REQUIRED is defined
  *  RB_TREE_USER_DATA_TYPE - defines user data to be added to the node
  *  RB_TREE_COUNT_REQUIRED - specifies that nodes count shall be provided
  *  RB_TREE_FOREACH_REQUIRED - specifies, that tree_foreach function is required
+ *  RB_TREE_ITERATION_REQUIRED - specifies, that tree_first, tree_last, node_next and node_prev functions are required
  *  RB_TREE_CLEAR_REQUIRED - specifies that tree_clear function is required
+ *  RB_TREE_CLEAR_RETAINED_SIZE - count of nodes tree_clear keeps memory for, all the memory is kept by default
  *  RB_TREE_ASSERT - specifies assertion macro
  *
  * unmasked types/functions:
@@ -40,6 +49,10 @@
  *  is_valid_tree                   checks whether the tree structure and contents is sane
  *  print_tree                      prints tree contents to the FILE stream
  *  tree_foreach                    enumerates all the node in the ascending order
+ *  tree_first                      returns node with the smallest key
+ *  tree_last                       returns node with the largest key
+ *  node_next                       returns node that follows the given one in the ascending order
+ *  node_prev                       returns node that precedes the given one in the ascending order
  *  tree_clear                      clear tree contents
  *
  *  internal_check_context
@@ -169,8 +182,34 @@ typedef struct RB_TREE_NS(node)
 #define FIXED_ALLOC_INITIAL_CHUNK_SIZE   RB_TREE_INITIAL_CHUNK_SIZE
 #endif
 
+#ifdef RB_TREE_MAX_CHUNK_SIZE
+#define FIXED_ALLOC_MAX_CHUNK_SIZE   RB_TREE_MAX_CHUNK_SIZE
+#endif
+
+#ifdef RB_TREE_CLEAR_REQUIRED
+#define FIXED_ALLOC_CLEAR_REQUIRED
+#endif
+
+#ifdef RB_TREE_CLEAR_RETAINED_SIZE
+#define FIXED_ALLOC_CLEAR_RETAINED_SIZE   RB_TREE_CLEAR_RETAINED_SIZE
+#endif
+
 #ifdef RB_TREE_REMOVE_NODE_REQUIRED
 #define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+/* constant-time lookup of the node's cluster on removal */
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#ifdef RB_TREE_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#endif
+
+#ifdef RB_TREE_XMALLOC_ALIGNED
+#define FIXED_ALLOC_XMALLOC_ALIGNED RB_TREE_XMALLOC_ALIGNED
+#define FIXED_ALLOC_XFREE_ALIGNED   RB_TREE_XFREE_ALIGNED
+#endif
+
+#ifdef RB_TREE_MMAP_REGIONS
+#define FIXED_ALLOC_MMAP_REGIONS
+#endif
 #endif
 
 #ifdef RB_TREE_IS_VALID_TREE_REQUIRED
@@ -1078,12 +1117,133 @@ End:
 
 #endif
 
+#ifdef RB_TREE_ITERATION_REQUIRED
+
+/*
+ * returns node with the smallest key or NULL if tree is empty
+ */
+static RB_TREE_NS(node) * RB_TREE_NS(tree_first)(RB_TREE_NS(tree) * tree)
+{
+    const RB_TREE_NS(node) * leaf = &tree->leaf;
+    RB_TREE_NS(node) * node = tree->root;
+
+    if (node == leaf)
+    {
+        return NULL;
+    }
+
+    while (node->left != leaf)
+    {
+        node = node->left;
+    }
+
+    return node;
+}
+
+/*
+ * returns node with the largest key or NULL if tree is empty
+ */
+static RB_TREE_NS(node) * RB_TREE_NS(tree_last)(RB_TREE_NS(tree) * tree)
+{
+    const RB_TREE_NS(node) * leaf = &tree->leaf;
+    RB_TREE_NS(node) * node = tree->root;
+
+    if (node == leaf)
+    {
+        return NULL;
+    }
+
+    while (node->right != leaf)
+    {
+        node = node->right;
+    }
+
+    return node;
+}
+
+/*
+ * returns node that follows the given one in the ascending order or NULL if the given node is the last one,
+ * the tree shall not be modified while it is traversed, since removal may move keys between the nodes
+ */
+static RB_TREE_NS(node) * RB_TREE_NS(node_next)(RB_TREE_NS(tree) * tree, RB_TREE_NS(node) * node)
+{
+    const RB_TREE_NS(node) * leaf = &tree->leaf;
+
+    RB_TREE_ASSERT((node != NULL) && (node != leaf));
+
+    /* the smallest node of the right subtree */
+    if (node->right != leaf)
+    {
+        node = node->right;
+
+        while (node->left != leaf)
+        {
+            node = node->left;
+        }
+
+        return node;
+    }
+
+    /* go up until the node is in the left subtree of its parent */
+    while ((node->parent != NULL) && (node->parent->right == node))
+    {
+        node = node->parent;
+    }
+
+    return node->parent;
+}
+
+/*
+ * returns node that precedes the given one in the ascending order or NULL if the given node is the first one
+ */
+static RB_TREE_NS(node) * RB_TREE_NS(node_prev)(RB_TREE_NS(tree) * tree, RB_TREE_NS(node) * node)
+{
+    const RB_TREE_NS(node) * leaf = &tree->leaf;
+
+    RB_TREE_ASSERT((node != NULL) && (node != leaf));
+
+    /* the largest node of the left subtree */
+    if (node->left != leaf)
+    {
+        node = node->left;
+
+        while (node->right != leaf)
+        {
+            node = node->right;
+        }
+
+        return node;
+    }
+
+    /* go up until the node is in the right subtree of its parent */
+    while ((node->parent != NULL) && (node->parent->left == node))
+    {
+        node = node->parent;
+    }
+
+    return node->parent;
+}
+
+#endif // RB_TREE_ITERATION_REQUIRED
+
 #ifdef RB_TREE_CLEAR_REQUIRED
 
 static void RB_TREE_NS(tree_clear)(RB_TREE_NS(tree) * tree)
 {
-    RB_TREE_NS(uninit_tree)(tree);
-    RB_TREE_NS(init_tree)(tree);
+    RB_TREE_NS(node) * leaf = &tree->leaf;
+
+    // nodes memory is kept for the subsequent insertions
+    RB_TREE_FIXED_ALLOC_NS(allocator_clear)(&tree->allocator);
+
+    leaf->color = RB_TREE_BLACK;
+    leaf->left = leaf->right = leaf;
+    leaf->parent = NULL;
+
+    tree->root = leaf;
+
+#ifdef RB_TREE_COUNT_REQUIRED
+    tree->count = 0;
+#endif
 }
 
 #endif
@@ -1110,7 +1270,14 @@ static void RB_TREE_NS(tree_clear)(RB_TREE_NS(tree) * tree)
 #undef RB_TREE_IS_VALID_TREE_REQUIRED
 #undef RB_TREE_PRINT_NODE
 #undef RB_TREE_INITIAL_CHUNK_SIZE
+#undef RB_TREE_MAX_CHUNK_SIZE
+#undef RB_TREE_RELEASE_EMPTY_CLUSTERS
+#undef RB_TREE_XMALLOC_ALIGNED
+#undef RB_TREE_XFREE_ALIGNED
+#undef RB_TREE_MMAP_REGIONS
 #undef RB_TREE_USER_DATA_TYPE
 #undef RB_TREE_COUNT_REQUIRED
 #undef RB_TREE_FOREACH_REQUIRED
+#undef RB_TREE_ITERATION_REQUIRED
 #undef RB_TREE_CLEAR_REQUIRED
+#undef RB_TREE_CLEAR_RETAINED_SIZE
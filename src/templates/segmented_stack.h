@@ -0,0 +1,228 @@
+/*
+ * template implementation of the segmented stack data structure and operations on it.
+ *
+ * the stack's elements are kept in the fixed-size segments linked to each other, so the push operation
+ * never moves the elements being stored and takes constant time in the worst case.
+ * the last released segment is cached by the stack to be reused when the stack grows again,
+ * so pushing and popping elements at the segment's boundary does not allocate memory each time.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  SEGMENTED_STACK_ELEMENT_TYPE - defines element type
+ *  SEGMENTED_STACK_XMALLOC - defines memory allocation function, that never returns 0
+ *  SEGMENTED_STACK_XFREE - defines memory releasing function
+ *
+ * optional macros:
+ *  SEGMENTED_STACK_NS - namespace macro
+ *  SEGMENTED_STACK_ASSERT - specifies user-level assert macro
+ *  SEGMENTED_STACK_SEGMENT_SIZE - count of elements in the segment, 256 by default
+ *
+ * unmasked types/functions:
+ *  segmented_stack         stack structure
+ *  segmented_stack_init    initializes stack
+ *  segmented_stack_uninit  uninitializes stack
+ *  segmented_stack_push    pushes the given element to the stack and returns its address
+ *  segmented_stack_pop     pops last element from the stack
+ *  segmented_stack_top     returns address of the last element of the stack
+ *  segmented_stack_size    returns count of elements in the stack
+ *  segmented_stack_empty   returns true if stack is empty, false otherwise
+ *
+ *  internal_segment        internally used segment structure
+ *  internal_push_segment   internal function
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef SEGMENTED_STACK_NS
+#define SEGMENTED_STACK_NS(name) name
+#endif
+
+#ifndef SEGMENTED_STACK_ELEMENT_TYPE
+#error SEGMENTED_STACK_ELEMENT_TYPE is not defined
+#endif
+
+#ifndef SEGMENTED_STACK_XMALLOC
+#error SEGMENTED_STACK_XMALLOC is not been defined
+#endif
+
+#ifndef SEGMENTED_STACK_XFREE
+#error SEGMENTED_STACK_XFREE is not been defined
+#endif
+
+#ifndef SEGMENTED_STACK_ASSERT
+#include <assert.h>
+#define SEGMENTED_STACK_ASSERT(x) assert(x)
+#endif
+
+#ifndef SEGMENTED_STACK_SEGMENT_SIZE
+#define SEGMENTED_STACK_SEGMENT_SIZE  (256)
+#endif
+
+/**
+ * segment of the stack
+ */
+typedef struct SEGMENTED_STACK_NS(internal_segment)
+{
+    struct SEGMENTED_STACK_NS(internal_segment) *   prev;
+    SEGMENTED_STACK_ELEMENT_TYPE                    elements[SEGMENTED_STACK_SEGMENT_SIZE];
+} SEGMENTED_STACK_NS(internal_segment);
+
+/**
+ * stack data structure
+ */
+typedef struct SEGMENTED_STACK_NS(segmented_stack)
+{
+    /* segment that holds the last elements of the stack */
+    SEGMENTED_STACK_NS(internal_segment) *  top;
+
+    /* released segment, that is reused by the next segment allocation */
+    SEGMENTED_STACK_NS(internal_segment) *  spare;
+
+    /* count of elements in the top segment, the segment is considered as full when there is no one */
+    size_t                                  top_size;
+
+    size_t                                  size;
+} SEGMENTED_STACK_NS(segmented_stack);
+
+/**
+ * initializes the given stack structure
+ */
+static void SEGMENTED_STACK_NS(segmented_stack_init)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    stack->top = NULL;
+    stack->spare = NULL;
+    stack->top_size = SEGMENTED_STACK_SEGMENT_SIZE;
+    stack->size = 0;
+}
+
+/**
+ * uninitializes the given stack structure
+ */
+static void SEGMENTED_STACK_NS(segmented_stack_uninit)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    SEGMENTED_STACK_NS(internal_segment) * segment = stack->top;
+
+    while (NULL != segment)
+    {
+        SEGMENTED_STACK_NS(internal_segment) * prev = segment->prev;
+        SEGMENTED_STACK_XFREE(segment);
+        segment = prev;
+    }
+
+    SEGMENTED_STACK_XFREE(stack->spare);
+}
+
+/**
+ * links new top segment to the stack, the cached one is used if any
+ * \param stack     destination stack
+ */
+static void SEGMENTED_STACK_NS(internal_push_segment)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    SEGMENTED_STACK_NS(internal_segment) * segment = stack->spare;
+
+    if (NULL == segment)
+    {
+        segment = SEGMENTED_STACK_XMALLOC(sizeof(SEGMENTED_STACK_NS(internal_segment)));
+    }
+
+    stack->spare = NULL;
+
+    segment->prev = stack->top;
+    stack->top = segment;
+    stack->top_size = 0;
+}
+
+/**
+ * pushes the given element to the stack
+ * \param stack     destination stack
+ * \param element   source element
+ * \return address of the pushed element, it remains valid until the element is popped
+ */
+static SEGMENTED_STACK_ELEMENT_TYPE * SEGMENTED_STACK_NS(segmented_stack_push)(SEGMENTED_STACK_NS(segmented_stack) * stack,
+                                                                               SEGMENTED_STACK_ELEMENT_TYPE element)
+{
+    SEGMENTED_STACK_ELEMENT_TYPE * result;
+
+    if (stack->top_size == SEGMENTED_STACK_SEGMENT_SIZE)
+    {
+        SEGMENTED_STACK_NS(internal_push_segment)(stack);
+    }
+
+    result = &stack->top->elements[stack->top_size++];
+    *result = element;
+    ++stack->size;
+
+    return result;
+}
+
+/**
+ * pops the last element from the stack
+ * this function shall not be called if the stack is empty
+ * \param stack     source stack
+ * \return popped element
+ */
+static SEGMENTED_STACK_ELEMENT_TYPE SEGMENTED_STACK_NS(segmented_stack_pop)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    SEGMENTED_STACK_ELEMENT_TYPE element;
+    SEGMENTED_STACK_ASSERT(stack->size > 0);
+
+    element = stack->top->elements[--stack->top_size];
+    --stack->size;
+
+    if (0 == stack->top_size)
+    {
+        /* top segment is empty, cache it instead of the previously cached one */
+        SEGMENTED_STACK_NS(internal_segment) * segment = stack->top;
+
+        stack->top = segment->prev;
+        stack->top_size = SEGMENTED_STACK_SEGMENT_SIZE;
+
+        SEGMENTED_STACK_XFREE(stack->spare);
+        stack->spare = segment;
+    }
+
+    return element;
+}
+
+/**
+ * returns address of the last element of the stack
+ * this function shall not be called if the stack is empty
+ * \param stack     source stack
+ * \return address of the last element
+ */
+static inline SEGMENTED_STACK_ELEMENT_TYPE * SEGMENTED_STACK_NS(segmented_stack_top)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    SEGMENTED_STACK_ASSERT(stack->size > 0);
+    return &stack->top->elements[stack->top_size - 1];
+}
+
+/**
+ * returns count of elements in the given stack
+ */
+static inline size_t SEGMENTED_STACK_NS(segmented_stack_size)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    return stack->size;
+}
+
+/**
+ * returns true if the given stack is empty
+ */
+static inline bool SEGMENTED_STACK_NS(segmented_stack_empty)(SEGMENTED_STACK_NS(segmented_stack) * stack)
+{
+    return (stack->size == 0);
+}
+
+/*
+ * undefine user macros
+ */
+#undef SEGMENTED_STACK_ELEMENT_TYPE
+#undef SEGMENTED_STACK_XMALLOC
+#undef SEGMENTED_STACK_XFREE
+#undef SEGMENTED_STACK_NS
+#undef SEGMENTED_STACK_ASSERT
+#undef SEGMENTED_STACK_SEGMENT_SIZE
@@ -0,0 +1,237 @@
+/*
+ * template implementation of the vectorized search over the small sorted arrays of arithmetic keys.
+ *
+ * the position of the key in the sorted array is the count of elements that are less than the key,
+ * so the elements are compared to the key by the vector instructions and the comparison results
+ * are counted, there are no branches that depend on the comparison results.
+ * it beats binary search on the arrays that occupy a few cache lines, the larger arrays are
+ * to be searched by means of bsearch.h.
+ *
+ * the vector code is written for gcc and clang by means of vector extensions and x86 intrinsics:
+ * SSE2 (x86-64 baseline) is used by default, AVX2 is used if the processor supports it,
+ * that is checked at runtime. the other compilers and targets get the scalar code.
+ *
+ * this file comes under the MIT license that described at
+ * http://www.opensource.org/licenses/mit-license.php.
+ *
+ * the template instantiation is controlled by the following macro definitions:
+ *
+ * required macros:
+ *  SIMD_SEARCH_KEY_TYPE - defines arithmetic key type of 1, 2, 4 or 8 bytes, the array is ordered
+ *                         by the built-in comparison operators
+ *
+ * optional macros:
+ *  SIMD_SEARCH_NS - namespace macro
+ *
+ * unmasked types/functions:
+ *  simd_lower_bound            returns index of the first element that is not less than the key
+ *  simd_binary_search          returns index of the element that is equal to the key
+ *
+ *  internal_lower_bound        internal function
+ *  internal_count_less_sse2    internal function
+ *  internal_count_less_avx2    internal function
+ */
+
+/*
+ sample usage:
+
+    // define type names
+    #define SIMD_SEARCH_NS(name)    char_##name
+    #define SIMD_SEARCH_KEY_TYPE    char
+
+    #include <templates/simd_search.h>
+
+    ...
+    const char chars[] = "aeiou";
+
+    index = char_simd_binary_search(chars, 5, 'o');
+ */
+
+#include <stddef.h>
+
+#ifndef SIMD_SEARCH_NS
+#define SIMD_SEARCH_NS(name) name
+#endif
+
+#ifndef SIMD_SEARCH_KEY_TYPE
+#error SIMD_SEARCH_KEY_TYPE is not defined
+#endif
+
+#ifndef SIMD_SEARCH_INTERNAL_DEFINED
+#define SIMD_SEARCH_INTERNAL_DEFINED
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_SEARCH_INTERNAL_AVX2
+#if defined(__SSE2__)
+#define SIMD_SEARCH_INTERNAL_SSE2
+#endif
+#endif
+
+#endif /* SIMD_SEARCH_INTERNAL_DEFINED */
+
+
+/**
+ * finds the first element of the sorted array that is not less than the key given without vector instructions,
+ * the search range is halved on each step regardless of the comparison result, the same way as
+ * bsearch.h's branchless_lower_bound does
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value
+ * \returns size_t      index of the found element or count if all the elements are less than the key
+ */
+static size_t
+SIMD_SEARCH_NS(internal_lower_bound)(const SIMD_SEARCH_KEY_TYPE * array, size_t count, SIMD_SEARCH_KEY_TYPE key)
+{
+    size_t base = 0;
+
+    if (0 == count)
+    {
+        return 0;
+    }
+
+    while (count > 1)
+    {
+        size_t half = count / 2;
+
+        base = (array[base + half] < key) ? base + half : base;
+        count -= half;
+    }
+
+    return base + (array[base] < key);
+}
+
+#ifdef SIMD_SEARCH_INTERNAL_SSE2
+
+/**
+ * counts elements of the sorted array that are less than the key given by means of 16-byte vectors,
+ * the elements that are less than the key form the prefix of each vector, so the count of trailing ones
+ * of the comparison's byte mask gives the count of such elements multiplied by the element size
+ * \param array         source array, holds at least one vector of elements
+ * \param count         count of elements in the array
+ * \param key           key value
+ * \returns size_t      count of elements that are less than the key
+ */
+static size_t
+SIMD_SEARCH_NS(internal_count_less_sse2)(const SIMD_SEARCH_KEY_TYPE * array, size_t count, SIMD_SEARCH_KEY_TYPE key)
+{
+    typedef SIMD_SEARCH_KEY_TYPE vector_type __attribute__((vector_size(16)));
+    const size_t lanes = sizeof(vector_type) / sizeof(SIMD_SEARCH_KEY_TYPE);
+    const vector_type keys = (vector_type){ 0 } + key;
+    vector_type elements;
+    size_t bytes = 0;
+    size_t last_bytes;
+    size_t i;
+
+    for (i = 0; i + lanes < count; i += lanes)
+    {
+        __builtin_memcpy(&elements, array + i, sizeof(elements));
+        bytes += (size_t)__builtin_ctz(~(unsigned int)_mm_movemask_epi8((__m128i)(elements < keys)));
+    }
+
+    // the last vector overlaps the previous one, its result is taken only if it is not empty
+    __builtin_memcpy(&elements, array + count - lanes, sizeof(elements));
+    last_bytes = (size_t)__builtin_ctz(~(unsigned int)_mm_movemask_epi8((__m128i)(elements < keys)));
+
+    return (0 != last_bytes) ? count - lanes + last_bytes / sizeof(SIMD_SEARCH_KEY_TYPE)
+                             : bytes / sizeof(SIMD_SEARCH_KEY_TYPE);
+}
+
+#endif /* SIMD_SEARCH_INTERNAL_SSE2 */
+
+#ifdef SIMD_SEARCH_INTERNAL_AVX2
+
+/**
+ * counts elements of the sorted array that are less than the key given by means of 32-byte vectors,
+ * shall be called only if the processor supports AVX2
+ * \param array         source array, holds at least one vector of elements
+ * \param count         count of elements in the array
+ * \param key           key value
+ * \returns size_t      count of elements that are less than the key
+ */
+__attribute__((target("avx2"))) static size_t
+SIMD_SEARCH_NS(internal_count_less_avx2)(const SIMD_SEARCH_KEY_TYPE * array, size_t count, SIMD_SEARCH_KEY_TYPE key)
+{
+    typedef SIMD_SEARCH_KEY_TYPE vector_type __attribute__((vector_size(32)));
+    const size_t lanes = sizeof(vector_type) / sizeof(SIMD_SEARCH_KEY_TYPE);
+    const vector_type keys = (vector_type){ 0 } + key;
+    vector_type elements;
+    size_t bytes = 0;
+    size_t last_bytes;
+    size_t i;
+
+    // the byte mask is 32-bit wide, so its inversion is extended to keep it non-zero
+    for (i = 0; i + lanes < count; i += lanes)
+    {
+        __builtin_memcpy(&elements, array + i, sizeof(elements));
+        bytes += (size_t)__builtin_ctzll(~(unsigned long long)(unsigned int)
+                                         _mm256_movemask_epi8((__m256i)(elements < keys)));
+    }
+
+    __builtin_memcpy(&elements, array + count - lanes, sizeof(elements));
+    last_bytes = (size_t)__builtin_ctzll(~(unsigned long long)(unsigned int)
+                                         _mm256_movemask_epi8((__m256i)(elements < keys)));
+
+    return (0 != last_bytes) ? count - lanes + last_bytes / sizeof(SIMD_SEARCH_KEY_TYPE)
+                             : bytes / sizeof(SIMD_SEARCH_KEY_TYPE);
+}
+
+#endif /* SIMD_SEARCH_INTERNAL_AVX2 */
+
+/**
+ * finds the first element of the sorted array that is not less than the key given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns size_t      index of the found element or count if all the elements are less than the key
+ */
+static size_t
+SIMD_SEARCH_NS(simd_lower_bound)(const SIMD_SEARCH_KEY_TYPE * array, size_t count, SIMD_SEARCH_KEY_TYPE key)
+{
+#ifdef SIMD_SEARCH_INTERNAL_AVX2
+    if ((count >= 32 / sizeof(SIMD_SEARCH_KEY_TYPE)) && __builtin_cpu_supports("avx2"))
+    {
+        return SIMD_SEARCH_NS(internal_count_less_avx2)(array, count, key);
+    }
+#endif
+
+#ifdef SIMD_SEARCH_INTERNAL_SSE2
+    if (count >= 16 / sizeof(SIMD_SEARCH_KEY_TYPE))
+    {
+        return SIMD_SEARCH_NS(internal_count_less_sse2)(array, count, key);
+    }
+#endif
+
+    // the arrays that are shorter than a vector are searched without vector instructions
+    return SIMD_SEARCH_NS(internal_lower_bound)(array, count, key);
+}
+
+/**
+ * performs search over the sorted array given
+ * \param array         source array
+ * \param count         count of elements in the array
+ * \param key           key value to be searched
+ * \returns ptrdiff_t   non-negative index of the first corresponding array element
+ *                      if such exists, or negative value that represents
+ *                      binary negation of the target index
+ *                      before what the source element is to be inserted
+ */
+static ptrdiff_t
+SIMD_SEARCH_NS(simd_binary_search)(const SIMD_SEARCH_KEY_TYPE * array, size_t count, SIMD_SEARCH_KEY_TYPE key)
+{
+    size_t index = SIMD_SEARCH_NS(simd_lower_bound)(array, count, key);
+
+    if ((index < count) && (array[index] == key))
+    {
+        return (ptrdiff_t)index;
+    }
+
+    return ~(ptrdiff_t)index;
+}
+
+
+/*
+ * undefine user macros
+ */
+#undef SIMD_SEARCH_NS
+#undef SIMD_SEARCH_KEY_TYPE
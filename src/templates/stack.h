@@ -15,10 +15,15 @@
  * optional macros:
  *  STACK_NS - namespace macro
  *  STACK_ASSERT - specifies user-level assert macro
- *  STACK_GROW_SIZE - specifies grow size constant that is used to recalculate reallocation size
+ *  STACK_GROW_SIZE - specifies grow size constant that is used to recalculate reallocation size,
+ *                    if STACK_GROW_FACTOR is defined it specifies the initial allocation size
+ *  STACK_GROW_FACTOR - specifies that allocated size is multiplied by this factor (e.g. 2 or 1.5) on each
+ *                      reallocation, by default the grow size constant is added to the allocated size
  *  STACK_PREALLOCATED_SIZE - specifies that stack has preallocated part that
  *                               comes as a part of the stack structure
- *                               this can result in a benefit when using stack as a local variable
+ *                               this can result in a benefit when using stack as a local variable,
+ *                               the stack's elements pointer refers to the preallocated part until it is
+ *                               exhausted, so the initialized stack structure shall not be copied or moved
  *
  * unmasked types/functions:
  *  stack           stack structure
@@ -26,8 +31,15 @@
  *  stack_uninit    uninitializes stack
  *  stack_push      pushes the given element back to the specified stack
  *  stack_pop       pops last element from the stack
+ *  stack_top       returns last element of the stack
+ *  stack_push_n    pushes the given elements to the stack
+ *  stack_pop_n     pops the given count of the last elements from the stack
+ *  stack_reserve   makes stack capable to hold the given count of elements without reallocation
  *  stack_empty     returns true if stack is empty, false otherwise
  *
+ *  internal_set_capacity
+ *  internal_grow
+ *
  * Alexander Shabanov, 2008-2009
  * mailto:avshabanov@gmail.com
  * http://www.alexshabanov.com
@@ -35,6 +47,8 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+/* for memcpy */
+#include <string.h>
 
 #ifndef STACK_NS
 #define STACK_NS(name) name
@@ -70,6 +84,7 @@ typedef struct STACK_NS(stack)
     STACK_ELEMENT_TYPE      prealloc_elements[STACK_PREALLOCATED_SIZE];
 #endif
 
+    /* active storage, either the preallocated array or the heap one */
     STACK_ELEMENT_TYPE *    elements;
 
     size_t                  allocated;
@@ -81,8 +96,13 @@ typedef struct STACK_NS(stack)
  */
 static void STACK_NS(stack_init)(STACK_NS(stack) * stack)
 {
+#ifdef STACK_PREALLOCATED_SIZE
+    stack->elements = stack->prealloc_elements;
+    stack->allocated = STACK_PREALLOCATED_SIZE;
+#else
     stack->elements = NULL;
     stack->allocated = 0;
+#endif
     stack->size = 0;
 }
 
@@ -91,46 +111,109 @@ static void STACK_NS(stack_init)(STACK_NS(stack) * stack)
  */
 static void STACK_NS(stack_uninit)(STACK_NS(stack) * stack)
 {
+#ifdef STACK_PREALLOCATED_SIZE
+    if (stack->elements == stack->prealloc_elements)
+    {
+        return;
+    }
+#endif
+
     STACK_XFREE(stack->elements);
 }
 
 /**
- * pushes the given element to the stack
- * \param stack     destination stack
- * \param element   source element
+ * reallocates the stack's elements
+ * \param stack     source stack
+ * \param capacity  new count of elements the stack is able to hold, shall be greater than the allocated one
  */
-static void STACK_NS(stack_push)(STACK_NS(stack) * stack, STACK_ELEMENT_TYPE element)
+static void STACK_NS(internal_set_capacity)(STACK_NS(stack) * stack, size_t capacity)
 {
+    STACK_ASSERT(capacity > stack->allocated);
+
 #ifdef STACK_PREALLOCATED_SIZE
-    if (stack->size < STACK_PREALLOCATED_SIZE)
+    if (stack->elements == stack->prealloc_elements)
+    {
+        /* allocate new array and copy existing elements to it */
+        stack->elements = STACK_XREALLOC(0, sizeof(STACK_ELEMENT_TYPE) * capacity);
+        memcpy(stack->elements, stack->prealloc_elements, sizeof(STACK_ELEMENT_TYPE) * stack->size);
+        stack->allocated = capacity;
+        return;
+    }
+#endif
+
+    stack->elements = STACK_XREALLOC(stack->elements, sizeof(STACK_ELEMENT_TYPE) * capacity);
+    stack->allocated = capacity;
+}
+
+/**
+ * grows the stack according to the grow policy so that it is able to hold the given count of elements
+ * \param stack     source stack
+ * \param required  count of elements the stack shall be able to hold
+ */
+static void STACK_NS(internal_grow)(STACK_NS(stack) * stack, size_t required)
+{
+#ifdef STACK_GROW_FACTOR
+    size_t capacity = (size_t)(stack->allocated * STACK_GROW_FACTOR);
+
+    if (capacity < STACK_GROW_SIZE)
     {
-        /* element can be placed into the preallocated stack */
-        stack->prealloc_elements[stack->size] = element;
+        capacity = STACK_GROW_SIZE;
     }
-    else
+#else
+    size_t capacity = (stack->allocated / STACK_GROW_SIZE + 1) * STACK_GROW_SIZE;
+#endif
+
+    if (capacity < required)
     {
-        /* place element into the allocated array */
-        size_t alloc_size = stack->size - STACK_PREALLOCATED_SIZE;
+        capacity = required;
+    }
 
-        if ((alloc_size + 1) > stack->allocated)
-        {
-            stack->allocated += STACK_GROW_SIZE;
-            stack->elements = STACK_XREALLOC(stack->elements, sizeof(STACK_ELEMENT_TYPE) * stack->allocated);
-        }
+    STACK_NS(internal_set_capacity)(stack, capacity);
+}
 
-        stack->elements[alloc_size] = element;
+/**
+ * makes the stack capable to hold the given count of elements without reallocation
+ * \param stack     source stack
+ * \param capacity  count of elements
+ */
+static inline void STACK_NS(stack_reserve)(STACK_NS(stack) * stack, size_t capacity)
+{
+    if (capacity > stack->allocated)
+    {
+        STACK_NS(internal_set_capacity)(stack, capacity);
     }
+}
 
-    ++stack->size;
-#else
-    if ((stack->size + 1) > stack->allocated)
+/**
+ * pushes the given element to the stack
+ * \param stack     destination stack
+ * \param element   source element
+ */
+static void STACK_NS(stack_push)(STACK_NS(stack) * stack, STACK_ELEMENT_TYPE element)
+{
+    if (stack->size == stack->allocated)
     {
-        stack->allocated += STACK_GROW_SIZE;
-        stack->elements = STACK_XREALLOC(stack->elements, sizeof(STACK_ELEMENT_TYPE) * stack->allocated);
+        STACK_NS(internal_grow)(stack, stack->size + 1);
     }
 
     stack->elements[stack->size++] = element;
-#endif
+}
+
+/**
+ * pushes the given elements to the stack, the last one of them becomes the top of the stack
+ * \param stack     destination stack
+ * \param elements  source elements, shall not point to the stack's own elements
+ * \param count     count of elements
+ */
+static inline void STACK_NS(stack_push_n)(STACK_NS(stack) * stack, const STACK_ELEMENT_TYPE * elements, size_t count)
+{
+    if ((stack->size + count) > stack->allocated)
+    {
+        STACK_NS(internal_grow)(stack, stack->size + count);
+    }
+
+    memcpy(stack->elements + stack->size, elements, sizeof(STACK_ELEMENT_TYPE) * count);
+    stack->size += count;
 }
 
 /**
@@ -141,25 +224,39 @@ static void STACK_NS(stack_push)(STACK_NS(stack) * stack, STACK_ELEMENT_TYPE ele
  */
 static STACK_ELEMENT_TYPE STACK_NS(stack_pop)(STACK_NS(stack) * stack)
 {
-    STACK_ELEMENT_TYPE element;
     STACK_ASSERT(stack->size > 0);
+    return stack->elements[--stack->size];
+}
 
-#ifdef STACK_PREALLOCATED_SIZE
-    --stack->size;
+/**
+ * pops the given count of the last elements from the stack
+ * this function shall not be called if the stack holds less elements
+ * \param stack     source stack
+ * \param elements  destination, receives popped elements in the order they have been pushed,
+ *                  so the former top of the stack becomes the last one, may be NULL
+ * \param count     count of elements
+ */
+static inline void STACK_NS(stack_pop_n)(STACK_NS(stack) * stack, STACK_ELEMENT_TYPE * elements, size_t count)
+{
+    STACK_ASSERT(stack->size >= count);
+    stack->size -= count;
 
-    if (stack->size < STACK_PREALLOCATED_SIZE)
-    {
-        element = stack->prealloc_elements[stack->size];
-    }
-    else
+    if (NULL != elements)
     {
-        element = stack->elements[stack->size - STACK_PREALLOCATED_SIZE];
+        memcpy(elements, stack->elements + stack->size, sizeof(STACK_ELEMENT_TYPE) * count);
     }
-#else
-    element = stack->elements[--stack->size];
-#endif
+}
 
-    return element;
+/**
+ * returns the last element of the stack without popping it
+ * this function shall not be called if the stack is empty
+ * \param stack     source stack
+ * \return the last element
+ */
+static inline STACK_ELEMENT_TYPE STACK_NS(stack_top)(STACK_NS(stack) * stack)
+{
+    STACK_ASSERT(stack->size > 0);
+    return stack->elements[stack->size - 1];
 }
 
 /**
@@ -179,4 +276,5 @@ static inline bool STACK_NS(stack_empty)(STACK_NS(stack) * stack)
 #undef STACK_NS
 #undef STACK_ASSERT
 #undef STACK_GROW_SIZE
+#undef STACK_GROW_FACTOR
 #undef STACK_PREALLOCATED_SIZE
@@ -15,20 +15,56 @@
  * optional macros:
  *  VECTOR_NS - namespace macro
  *  VECTOR_ASSERT - specifies user-level assert macro
- *  VECTOR_GROW_SIZE - specifies grow size constant that is used to recalculate reallocation size
+ *  VECTOR_GROW_SIZE - specifies grow size constant that is used to recalculate reallocation size,
+ *                     if VECTOR_GROW_FACTOR is defined it specifies the initial allocation size
+ *  VECTOR_GROW_FACTOR - specifies that allocated size is multiplied by this factor (e.g. 2 or 1.5) on each
+ *                       reallocation, by default the grow size constant is added to the allocated size
  *  VECTOR_PREALLOCATED_SIZE - specifies that vector has preallocated part that
  *                             comes as a part of the vector structure what can result
- *                             in a valuable performance benefit when the vector's size is less than preallocated one
+ *                             in a valuable performance benefit when the vector's size is less than preallocated one,
+ *                             the vector's elements pointer refers to the preallocated part until it is exhausted,
+ *                             so the initialized vector structure shall not be copied or moved
  *  VECTOR_CLEAR_REQUIRED - specifies whether vector_clear function is required
+ *  VECTOR_3W_COMPARE(left, right) - three-way comparison of the two elements, specifies whether
+ *                                   vector_sort and vector_unique functions are required,
+ *                                   it shall return int value what is:
+ *                                   <0 if the left element is less than the right one
+ *                                   >0 if the left element is greater than the right one
+ *                                   ==0 if the elements are equal
+ *  VECTOR_RADIX_KEY(element) - specifies that vector_sort uses radix sort, the macro shall return
+ *                              unsigned integer key of the element that is ordered the same way
+ *                              as VECTOR_3W_COMPARE orders the elements
+ *  VECTOR_SORT_THREADS - specifies count of threads used by vector_sort, when defined large vectors
+ *                        are sorted in parallel, ignored if VECTOR_RADIX_KEY is defined
+ *  VECTOR_SORT_PARALLEL_THRESHOLD - minimal size of the vector that is sorted in parallel, 65536 by default
  *
  * unmasked types/functions:
  *  vector              vector structure
  *  vector_init         initializes vector
  *  vector_uninit       uninitializes vector
  *  vector_push_back    pushes back element to certain vector
+ *  vector_emplace_back appends uninitialized element to the vector and returns pointer to it
+ *  vector_append_n     copies the given range of elements to the end of the vector
+ *  vector_resize       changes size of the vector, new elements are left uninitialized
  *  vector_data         returns pointer to the vector's data
  *  vector_size         returns size of the vector
  *  vector_clear        empties vector's contents
+ *  vector_sort         sorts vector's contents, the sort is stable
+ *  vector_unique       removes consecutive equal elements
+ *  vector_reserve      makes vector capable to hold the given count of elements without reallocation
+ *  vector_shrink_to_fit releases memory that is not used by the vector's elements
+ *
+ *  internal_set_capacity
+ *  internal_grow
+ *  internal_insertion_sort
+ *  internal_merge
+ *  internal_merge_sort
+ *  internal_radix_sort
+ *  internal_sort_task
+ *  internal_sort_thread_proc
+ *  internal_merge_thread_proc
+ *  internal_run_sort_tasks
+ *  internal_parallel_sort
  *
  * Alexander Shabanov, 2008-2009
  * mailto:avshabanov@gmail.com
@@ -63,9 +99,19 @@
 #define VECTOR_GROW_SIZE  (256)
 #endif
 
-#ifdef VECTOR_PREALLOCATED_SIZE
 /* for memcpy */
 #include <string.h>
+
+#ifdef VECTOR_RADIX_KEY
+#include <stdint.h>
+#endif
+
+#if defined(VECTOR_SORT_THREADS) && !defined(VECTOR_RADIX_KEY)
+#include <pthread.h>
+
+#ifndef VECTOR_SORT_PARALLEL_THRESHOLD
+#define VECTOR_SORT_PARALLEL_THRESHOLD  (65536)
+#endif
 #endif
 
 
@@ -76,9 +122,9 @@ typedef struct
 {
 #ifdef VECTOR_PREALLOCATED_SIZE
     VECTOR_ELEMENT_TYPE         prealloc_elements[VECTOR_PREALLOCATED_SIZE];
-    bool                        prealloc_used;
 #endif
 
+    /* active storage, either the preallocated array or the heap one */
     VECTOR_ELEMENT_TYPE *       elements;
 
     size_t                      allocated;
@@ -93,10 +139,12 @@ typedef struct
 static void VECTOR_NS(vector_init)(VECTOR_NS(vector) * vector)
 {
 #ifdef VECTOR_PREALLOCATED_SIZE
-    vector->prealloc_used = true;
-#endif
+    vector->elements = vector->prealloc_elements;
+    vector->allocated = VECTOR_PREALLOCATED_SIZE;
+#else
     vector->elements = NULL;
     vector->allocated = 0;
+#endif
     vector->size = 0;
 }
 
@@ -106,66 +154,188 @@ static void VECTOR_NS(vector_init)(VECTOR_NS(vector) * vector)
  */
 static void VECTOR_NS(vector_uninit)(VECTOR_NS(vector) * vector)
 {
+#ifdef VECTOR_PREALLOCATED_SIZE
+    if (vector->elements == vector->prealloc_elements)
+    {
+        return;
+    }
+#endif
+
     VECTOR_XFREE(vector->elements);
 }
 
 /**
- * pushes the element provided back to the vector
- * \param vector        source vector
- * \param element       element to be pushed back
+ * returns a pointer to the vector's data
+ * \param vector    source vector
+ * \return pointer to the elements array
  */
-static void VECTOR_NS(vector_push_back)(VECTOR_NS(vector) * vector, VECTOR_ELEMENT_TYPE element)
+static inline VECTOR_ELEMENT_TYPE * VECTOR_NS(vector_data)(VECTOR_NS(vector) * vector)
 {
+    return vector->elements;
+}
+
+/**
+ * reallocates the vector's elements
+ * \param vector    source vector
+ * \param capacity  new count of elements the vector is able to hold, shall not be less than the vector's size
+ */
+static void VECTOR_NS(internal_set_capacity)(VECTOR_NS(vector) * vector, size_t capacity)
+{
+    VECTOR_ASSERT(capacity >= vector->size);
+
 #ifdef VECTOR_PREALLOCATED_SIZE
-    if (vector->prealloc_used)
+    if (capacity <= VECTOR_PREALLOCATED_SIZE)
     {
-        VECTOR_ASSERT((NULL == vector->elements) && (0 == vector->allocated));
-
-        if (vector->size < VECTOR_PREALLOCATED_SIZE)
+        /* elements fit the preallocated array */
+        if (vector->elements != vector->prealloc_elements)
         {
-            /* element can be placed into the preallocated array */
-            vector->prealloc_elements[vector->size++] = element;
-            return;
+            memcpy(vector->prealloc_elements, vector->elements, vector->size * sizeof(VECTOR_ELEMENT_TYPE));
+            VECTOR_XFREE(vector->elements);
+
+            vector->elements = vector->prealloc_elements;
+            vector->allocated = VECTOR_PREALLOCATED_SIZE;
         }
 
-        /* preallocated array can not be used to store this element,
-         * allocate new array and copy existing elements to it
-         */
-        vector->prealloc_used = false;
-        vector->allocated = (VECTOR_PREALLOCATED_SIZE / VECTOR_GROW_SIZE + 1) * VECTOR_GROW_SIZE;
+        return;
+    }
+
+    if (vector->elements == vector->prealloc_elements)
+    {
+        /* allocate new array and copy existing elements to it */
+        vector->elements = VECTOR_XREALLOC(0, capacity * sizeof(VECTOR_ELEMENT_TYPE));
+        memcpy(vector->elements, vector->prealloc_elements, vector->size * sizeof(VECTOR_ELEMENT_TYPE));
+
+        vector->allocated = capacity;
+        return;
+    }
+#endif
 
-        VECTOR_ASSERT((vector->allocated > vector->size) && (VECTOR_PREALLOCATED_SIZE == vector->size));
+    if (0 == capacity)
+    {
+        VECTOR_XFREE(vector->elements);
+        vector->elements = NULL;
+    }
+    else
+    {
+        vector->elements = VECTOR_XREALLOC(vector->elements, capacity * sizeof(VECTOR_ELEMENT_TYPE));
+    }
 
-        vector->elements = VECTOR_XREALLOC(0, vector->allocated * sizeof(VECTOR_ELEMENT_TYPE));
+    vector->allocated = capacity;
+}
 
-        memcpy(vector->elements, vector->prealloc_elements, VECTOR_PREALLOCATED_SIZE * sizeof(VECTOR_ELEMENT_TYPE));
+/**
+ * grows the vector according to the grow policy so that it is able to hold the given count of elements
+ * \param vector    source vector
+ * \param required  count of elements the vector shall be able to hold
+ */
+static void VECTOR_NS(internal_grow)(VECTOR_NS(vector) * vector, size_t required)
+{
+    const size_t capacity = vector->allocated;
+
+#ifdef VECTOR_GROW_FACTOR
+    size_t new_capacity = (size_t)(capacity * VECTOR_GROW_FACTOR);
+
+    if (new_capacity < VECTOR_GROW_SIZE)
+    {
+        new_capacity = VECTOR_GROW_SIZE;
     }
+#else
+    size_t new_capacity = (capacity / VECTOR_GROW_SIZE + 1) * VECTOR_GROW_SIZE;
 #endif
 
-    if ((vector->size + 1) > vector->allocated)
+    if (new_capacity < required)
+    {
+        new_capacity = required;
+    }
+
+    VECTOR_NS(internal_set_capacity)(vector, new_capacity);
+}
+
+/**
+ * pushes the element provided back to the vector
+ * \param vector        source vector
+ * \param element       element to be pushed back
+ */
+static inline void VECTOR_NS(vector_push_back)(VECTOR_NS(vector) * vector, VECTOR_ELEMENT_TYPE element)
+{
+    if (vector->size == vector->allocated)
     {
-        vector->allocated += VECTOR_GROW_SIZE;
-        vector->elements = VECTOR_XREALLOC(vector->elements, sizeof(VECTOR_ELEMENT_TYPE) * vector->allocated);
+        VECTOR_NS(internal_grow)(vector, vector->size + 1);
     }
 
     vector->elements[vector->size++] = element;
 }
 
 /**
- * returns a pointer to the vector's data
+ * appends uninitialized element to the end of the vector
  * \param vector    source vector
- * \return pointer to the elements array
+ * \return pointer to the appended element, it remains valid until the next reallocation
  */
-static inline VECTOR_ELEMENT_TYPE * VECTOR_NS(vector_data)(VECTOR_NS(vector) * vector)
+static inline VECTOR_ELEMENT_TYPE * VECTOR_NS(vector_emplace_back)(VECTOR_NS(vector) * vector)
 {
-#ifdef VECTOR_PREALLOCATED_SIZE
-    if (vector->prealloc_used)
+    if (vector->size == vector->allocated)
     {
-        return vector->prealloc_elements;
+        VECTOR_NS(internal_grow)(vector, vector->size + 1);
     }
-#endif
 
-    return vector->elements;
+    return VECTOR_NS(vector_data)(vector) + vector->size++;
+}
+
+/**
+ * copies the given range of elements to the end of the vector
+ * \param vector    source vector
+ * \param elements  elements to be copied, shall not point to the vector's own data
+ * \param count     count of elements
+ */
+static inline void VECTOR_NS(vector_append_n)(VECTOR_NS(vector) * vector, const VECTOR_ELEMENT_TYPE * elements, size_t count)
+{
+    if ((vector->size + count) > vector->allocated)
+    {
+        VECTOR_NS(internal_grow)(vector, vector->size + count);
+    }
+
+    memcpy(VECTOR_NS(vector_data)(vector) + vector->size, elements, count * sizeof(VECTOR_ELEMENT_TYPE));
+    vector->size += count;
+}
+
+/**
+ * changes size of the vector, elements beyond the previous size are left uninitialized
+ * \param vector    source vector
+ * \param size      new size of the vector
+ */
+static inline void VECTOR_NS(vector_resize)(VECTOR_NS(vector) * vector, size_t size)
+{
+    if (size > vector->allocated)
+    {
+        VECTOR_NS(internal_grow)(vector, size);
+    }
+
+    vector->size = size;
+}
+
+/**
+ * makes the vector capable to hold the given count of elements without reallocation
+ * \param vector    source vector
+ * \param capacity  count of elements
+ */
+static inline void VECTOR_NS(vector_reserve)(VECTOR_NS(vector) * vector, size_t capacity)
+{
+    if (capacity > vector->allocated)
+    {
+        VECTOR_NS(internal_set_capacity)(vector, capacity);
+    }
+}
+
+/**
+ * releases memory that is not used by the vector's elements
+ * \param vector    source vector
+ */
+static inline void VECTOR_NS(vector_shrink_to_fit)(VECTOR_NS(vector) * vector)
+{
+    if (vector->size < vector->allocated)
+    {
+        VECTOR_NS(internal_set_capacity)(vector, vector->size);
+    }
 }
 
 /**
@@ -189,6 +359,371 @@ static void VECTOR_NS(vector_clear)(VECTOR_NS(vector) * vector)
 }
 #endif
 
+#ifdef VECTOR_3W_COMPARE
+
+/* size of the runs that are sorted by insertions before merging */
+#define VECTOR_INTERNAL_SORT_RUN        (16)
+
+/* minimal size of the vector that is sorted by radix sort */
+#define VECTOR_INTERNAL_RADIX_THRESHOLD (256)
+
+/**
+ * sorts the given elements by insertions
+ * \param elements  elements to be sorted
+ * \param count     count of elements
+ */
+static void VECTOR_NS(internal_insertion_sort)(VECTOR_ELEMENT_TYPE * elements, size_t count)
+{
+    size_t i;
+
+    for (i = 1; i < count; ++i)
+    {
+        VECTOR_ELEMENT_TYPE element = elements[i];
+        size_t j = i;
+
+        for (; (j > 0) && (VECTOR_3W_COMPARE(element, elements[j - 1]) < 0); --j)
+        {
+            elements[j] = elements[j - 1];
+        }
+
+        elements[j] = element;
+    }
+}
+
+/**
+ * merges two sorted ranges, equal elements of the left range precede the ones of the right range
+ * \param left          left range
+ * \param left_count    count of elements in the left range
+ * \param right         right range
+ * \param right_count   count of elements in the right range
+ * \param dest          destination, shall not overlap with the source ranges
+ */
+static void VECTOR_NS(internal_merge)(const VECTOR_ELEMENT_TYPE * left, size_t left_count,
+                                      const VECTOR_ELEMENT_TYPE * right, size_t right_count,
+                                      VECTOR_ELEMENT_TYPE * dest)
+{
+    while ((left_count > 0) && (right_count > 0))
+    {
+        if (VECTOR_3W_COMPARE(*right, *left) < 0)
+        {
+            *dest++ = *right++;
+            --right_count;
+        }
+        else
+        {
+            *dest++ = *left++;
+            --left_count;
+        }
+    }
+
+    memcpy(dest, left, left_count * sizeof(VECTOR_ELEMENT_TYPE));
+    memcpy(dest + left_count, right, right_count * sizeof(VECTOR_ELEMENT_TYPE));
+}
+
+/**
+ * sorts the given elements by bottom-up merge sort
+ * \param elements  elements to be sorted
+ * \param buffer    temporary buffer, that is able to hold count elements
+ * \param count     count of elements
+ */
+static void VECTOR_NS(internal_merge_sort)(VECTOR_ELEMENT_TYPE * elements, VECTOR_ELEMENT_TYPE * buffer, size_t count)
+{
+    VECTOR_ELEMENT_TYPE * source = elements;
+    VECTOR_ELEMENT_TYPE * dest = buffer;
+    size_t width;
+    size_t i;
+
+    for (i = 0; i < count; i += VECTOR_INTERNAL_SORT_RUN)
+    {
+        const size_t run = count - i;
+        VECTOR_NS(internal_insertion_sort)(elements + i, run < VECTOR_INTERNAL_SORT_RUN ? run : VECTOR_INTERNAL_SORT_RUN);
+    }
+
+    for (width = VECTOR_INTERNAL_SORT_RUN; width < count; width *= 2)
+    {
+        VECTOR_ELEMENT_TYPE * t;
+
+        for (i = 0; i < count; i += 2 * width)
+        {
+            const size_t left_count = (count - i) < width ? (count - i) : width;
+            const size_t rest = count - i - left_count;
+
+            VECTOR_NS(internal_merge)(source + i, left_count, source + i + left_count, rest < width ? rest : width,
+                                      dest + i);
+        }
+
+        t = source;
+        source = dest;
+        dest = t;
+    }
+
+    if (source != elements)
+    {
+        memcpy(elements, source, count * sizeof(VECTOR_ELEMENT_TYPE));
+    }
+}
+
+#ifdef VECTOR_RADIX_KEY
+/**
+ * sorts the given elements by LSD radix sort, bytes that are equal in all the keys are skipped
+ * \param elements  elements to be sorted
+ * \param buffer    temporary buffer, that is able to hold count elements
+ * \param count     count of elements
+ */
+static void VECTOR_NS(internal_radix_sort)(VECTOR_ELEMENT_TYPE * elements, VECTOR_ELEMENT_TYPE * buffer, size_t count)
+{
+    const size_t key_bits = 8 * sizeof(VECTOR_RADIX_KEY(elements[0]));
+    VECTOR_ELEMENT_TYPE * source = elements;
+    VECTOR_ELEMENT_TYPE * dest = buffer;
+    size_t offsets[256];
+    size_t shift;
+    size_t i;
+
+    for (shift = 0; shift < key_bits; shift += 8)
+    {
+        VECTOR_ELEMENT_TYPE * t;
+        size_t offset = 0;
+
+        memset(offsets, 0, sizeof(offsets));
+        for (i = 0; i < count; ++i)
+        {
+            ++offsets[((uint64_t)VECTOR_RADIX_KEY(source[i]) >> shift) & 0xff];
+        }
+
+        if (offsets[((uint64_t)VECTOR_RADIX_KEY(source[0]) >> shift) & 0xff] == count)
+        {
+            /* all the keys have the same byte at this position */
+            continue;
+        }
+
+        for (i = 0; i < 256; ++i)
+        {
+            const size_t n = offsets[i];
+            offsets[i] = offset;
+            offset += n;
+        }
+
+        for (i = 0; i < count; ++i)
+        {
+            dest[offsets[((uint64_t)VECTOR_RADIX_KEY(source[i]) >> shift) & 0xff]++] = source[i];
+        }
+
+        t = source;
+        source = dest;
+        dest = t;
+    }
+
+    if (source != elements)
+    {
+        memcpy(elements, source, count * sizeof(VECTOR_ELEMENT_TYPE));
+    }
+}
+#endif
+
+#if defined(VECTOR_SORT_THREADS) && !defined(VECTOR_RADIX_KEY)
+/**
+ * defines part of the parallel sort, that is either sorting or merging of the adjacent parts
+ */
+typedef struct
+{
+    VECTOR_ELEMENT_TYPE *       source;
+    VECTOR_ELEMENT_TYPE *       dest;
+    size_t                      left_count;
+    size_t                      right_count;
+} VECTOR_NS(internal_sort_task);
+
+static void * VECTOR_NS(internal_sort_thread_proc)(void * p)
+{
+    VECTOR_NS(internal_sort_task) * task = p;
+    VECTOR_NS(internal_merge_sort)(task->source, task->dest, task->left_count);
+    return NULL;
+}
+
+static void * VECTOR_NS(internal_merge_thread_proc)(void * p)
+{
+    VECTOR_NS(internal_sort_task) * task = p;
+    VECTOR_NS(internal_merge)(task->source, task->left_count, task->source + task->left_count, task->right_count,
+                              task->dest);
+    return NULL;
+}
+
+/**
+ * runs the given tasks on the separate threads, the first task is run by the calling thread,
+ * the tasks which threads can not be created are run by the calling thread as well
+ */
+static void VECTOR_NS(internal_run_sort_tasks)(void * (* thread_proc)(void *), VECTOR_NS(internal_sort_task) * tasks,
+                                               size_t count)
+{
+    pthread_t threads[VECTOR_SORT_THREADS];
+    bool started[VECTOR_SORT_THREADS];
+    size_t i;
+
+    for (i = 1; i < count; ++i)
+    {
+        started[i] = (0 == pthread_create(&threads[i], NULL, thread_proc, &tasks[i]));
+    }
+
+    thread_proc(&tasks[0]);
+
+    for (i = 1; i < count; ++i)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            thread_proc(&tasks[i]);
+        }
+    }
+}
+
+/**
+ * sorts the parts of the given elements on the separate threads, then merges adjacent parts in parallel
+ * \param elements  elements to be sorted
+ * \param buffer    temporary buffer, that is able to hold count elements
+ * \param count     count of elements
+ */
+static void VECTOR_NS(internal_parallel_sort)(VECTOR_ELEMENT_TYPE * elements, VECTOR_ELEMENT_TYPE * buffer, size_t count)
+{
+    VECTOR_NS(internal_sort_task) tasks[VECTOR_SORT_THREADS];
+    size_t bounds[VECTOR_SORT_THREADS + 1];
+    size_t parts = VECTOR_SORT_THREADS;
+    VECTOR_ELEMENT_TYPE * source = elements;
+    VECTOR_ELEMENT_TYPE * dest = buffer;
+    size_t i;
+
+    for (i = 0; i <= parts; ++i)
+    {
+        bounds[i] = count / parts * i + (count % parts) * i / parts;
+    }
+
+    for (i = 0; i < parts; ++i)
+    {
+        tasks[i].source = elements + bounds[i];
+        tasks[i].dest = buffer + bounds[i];
+        tasks[i].left_count = bounds[i + 1] - bounds[i];
+        tasks[i].right_count = 0;
+    }
+
+    VECTOR_NS(internal_run_sort_tasks)(&VECTOR_NS(internal_sort_thread_proc), tasks, parts);
+
+    while (parts > 1)
+    {
+        VECTOR_ELEMENT_TYPE * t;
+        const size_t merges = parts / 2;
+
+        for (i = 0; i < merges; ++i)
+        {
+            tasks[i].source = source + bounds[2 * i];
+            tasks[i].dest = dest + bounds[2 * i];
+            tasks[i].left_count = bounds[2 * i + 1] - bounds[2 * i];
+            tasks[i].right_count = bounds[2 * i + 2] - bounds[2 * i + 1];
+        }
+
+        if (parts % 2)
+        {
+            /* odd part is not merged on this pass */
+            memcpy(dest + bounds[parts - 1], source + bounds[parts - 1],
+                   (bounds[parts] - bounds[parts - 1]) * sizeof(VECTOR_ELEMENT_TYPE));
+        }
+
+        VECTOR_NS(internal_run_sort_tasks)(&VECTOR_NS(internal_merge_thread_proc), tasks, merges);
+
+        for (i = 0; i <= merges; ++i)
+        {
+            bounds[i] = bounds[2 * i < parts ? 2 * i : parts];
+        }
+
+        if (parts % 2)
+        {
+            bounds[merges + 1] = count;
+        }
+
+        parts -= merges;
+
+        t = source;
+        source = dest;
+        dest = t;
+    }
+
+    if (source != elements)
+    {
+        memcpy(elements, source, count * sizeof(VECTOR_ELEMENT_TYPE));
+    }
+}
+#endif
+
+/**
+ * sorts the vector's elements in ascending order, equal elements retain their relative order
+ * \param vector    source vector
+ */
+static void VECTOR_NS(vector_sort)(VECTOR_NS(vector) * vector)
+{
+    VECTOR_ELEMENT_TYPE * buffer;
+
+    if (vector->size <= VECTOR_INTERNAL_SORT_RUN)
+    {
+        VECTOR_NS(internal_insertion_sort)(vector->elements, vector->size);
+        return;
+    }
+
+    buffer = VECTOR_XREALLOC(0, vector->size * sizeof(VECTOR_ELEMENT_TYPE));
+
+#if defined(VECTOR_RADIX_KEY)
+    if (vector->size >= VECTOR_INTERNAL_RADIX_THRESHOLD)
+    {
+        VECTOR_NS(internal_radix_sort)(vector->elements, buffer, vector->size);
+    }
+    else
+#elif defined(VECTOR_SORT_THREADS)
+    if (vector->size >= VECTOR_SORT_PARALLEL_THRESHOLD)
+    {
+        VECTOR_NS(internal_parallel_sort)(vector->elements, buffer, vector->size);
+    }
+    else
+#endif
+    {
+        VECTOR_NS(internal_merge_sort)(vector->elements, buffer, vector->size);
+    }
+
+    VECTOR_XFREE(buffer);
+}
+
+/**
+ * removes consecutive equal elements, so that the sorted vector contains unique elements only,
+ * the first one of the equal elements is retained
+ * \param vector    source vector
+ * \return new size of the vector
+ */
+static inline size_t VECTOR_NS(vector_unique)(VECTOR_NS(vector) * vector)
+{
+    VECTOR_ELEMENT_TYPE * elements = vector->elements;
+    size_t last = 0;
+    size_t i;
+
+    if (0 == vector->size)
+    {
+        return 0;
+    }
+
+    for (i = 1; i < vector->size; ++i)
+    {
+        if (0 != VECTOR_3W_COMPARE(elements[last], elements[i]))
+        {
+            elements[++last] = elements[i];
+        }
+    }
+
+    vector->size = last + 1;
+    return vector->size;
+}
+
+#undef VECTOR_INTERNAL_SORT_RUN
+#undef VECTOR_INTERNAL_RADIX_THRESHOLD
+
+#endif /* VECTOR_3W_COMPARE */
+
 /*
  * undefine user macros
  */
@@ -198,5 +733,10 @@ static void VECTOR_NS(vector_clear)(VECTOR_NS(vector) * vector)
 #undef VECTOR_NS
 #undef VECTOR_ASSERT
 #undef VECTOR_GROW_SIZE
+#undef VECTOR_GROW_FACTOR
 #undef VECTOR_PREALLOCATED_SIZE
 #undef VECTOR_CLEAR_REQUIRED
+#undef VECTOR_3W_COMPARE
+#undef VECTOR_RADIX_KEY
+#undef VECTOR_SORT_THREADS
+#undef VECTOR_SORT_PARALLEL_THRESHOLD
@@ -0,0 +1,165 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <stdio.h>
+
+/*
+ * searches over the sorted arrays of integers
+ */
+#define BSEARCH_NS(name)     bbs_##name
+#define BSEARCH_ARRAY_TYPE   const int *
+#define BSEARCH_KEY_TYPE     int
+#define BSEARCH_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+#define BSEARCH_BOUNDS_REQUIRED
+#define BSEARCH_BRANCHLESS_REQUIRED
+#include <templates/bsearch.h>
+
+#define BSEARCH_NS(name)     bbp_##name
+#define BSEARCH_ARRAY_TYPE   const int *
+#define BSEARCH_KEY_TYPE     int
+#define BSEARCH_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+#define BSEARCH_PREFETCH(array, index) __builtin_prefetch(&array[index])
+#define BSEARCH_BRANCHLESS_REQUIRED
+#define BSEARCH_BATCH_REQUIRED
+#include <templates/bsearch.h>
+
+/*
+ * searches over the same arrays arranged in Eytzinger order
+ */
+#define EYTZINGER_NS(name)      bey_##name
+#define EYTZINGER_ELEMENT_TYPE  int
+#define EYTZINGER_KEY_TYPE      int
+#define EYTZINGER_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+#define EYTZINGER_PREFETCH(array, index) __builtin_prefetch(&array[index])
+#include <templates/eytzinger.h>
+
+/*
+ * searches over the small arrays of characters, the same as lexical tree's nodes are
+ */
+#define BSEARCH_NS(name)     bch_##name
+#define BSEARCH_ARRAY_TYPE   const unsigned char *
+#define BSEARCH_KEY_TYPE     unsigned char
+#define BSEARCH_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+#define BSEARCH_BRANCHLESS_REQUIRED
+#include <templates/bsearch.h>
+
+#define BSEARCH_NS(name)     bcs_##name
+#define BSEARCH_ARRAY_TYPE   const unsigned char *
+#define BSEARCH_KEY_TYPE     unsigned char
+#define BSEARCH_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+#define BSEARCH_SIMD_THRESHOLD (256)
+#include <templates/bsearch.h>
+
+#define BENCH_BSEARCH_LOOKUPS   (1 << 20)
+
+/*
+ * looks up the pseudo-random keys, every second key is absent in the array
+ */
+#define BENCH_BSEARCH(name, expr) \
+    { \
+        size_t i; \
+        double start = ut_bench_time(); \
+        for (i = 0; i < BENCH_BSEARCH_LOOKUPS; ++i) \
+        { \
+            const int key = keys[i]; \
+            sum += (size_t)(expr); \
+        } \
+        sprintf(bench_name, "%s, size=%lu", name, (unsigned long)count); \
+        ut_bench_report(bench_name, BENCH_BSEARCH_LOOKUPS, ut_bench_time() - start); \
+    }
+
+static volatile size_t g_bench_bsearch_sink;
+
+static void bench_lookups(const int * arr, size_t count, int * keys, int * layout, ptrdiff_t * results)
+{
+    char bench_name[64];
+    unsigned int seed = 12345;
+    size_t sum = 0;
+    size_t i;
+
+    for (i = 0; i < BENCH_BSEARCH_LOOKUPS; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        keys[i] = (int)((seed >> 4) % (2 * count));
+    }
+
+    BENCH_BSEARCH("binary_search", bbs_binary_search(arr, (int)count, key));
+    BENCH_BSEARCH("lower_bound", bbs_lower_bound(arr, (int)count, key));
+    BENCH_BSEARCH("branchless_lower_bound", bbs_branchless_lower_bound(arr, count, key));
+    BENCH_BSEARCH("branchless_lower_bound w/prefetch", bbp_branchless_lower_bound(arr, count, key));
+
+    {
+        double start = ut_bench_time();
+        bbp_binary_search_batch(arr, count, keys, BENCH_BSEARCH_LOOKUPS, results);
+        sprintf(bench_name, "binary_search_batch, size=%lu", (unsigned long)count);
+        ut_bench_report(bench_name, BENCH_BSEARCH_LOOKUPS, ut_bench_time() - start);
+        sum += (size_t)results[BENCH_BSEARCH_LOOKUPS - 1];
+    }
+
+    bey_eytzinger_arrange(arr, count, layout);
+    BENCH_BSEARCH("eytzinger_lower_bound", bey_eytzinger_lower_bound(layout, count, key));
+
+    g_bench_bsearch_sink = sum;
+}
+
+static void bench_small_lookups(const unsigned char * chars, size_t count, const int * keys)
+{
+    char bench_name[64];
+    size_t sum = 0;
+
+    BENCH_BSEARCH("chars binary_search", bch_binary_search(chars, (int)count, (unsigned char)key));
+    BENCH_BSEARCH("chars branchless_lower_bound", bch_branchless_lower_bound(chars, count, (unsigned char)key));
+    BENCH_BSEARCH("chars simd binary_search", bcs_binary_search(chars, (int)count, (unsigned char)key));
+
+    g_bench_bsearch_sink = sum;
+}
+
+/*
+ * function that launches benchmarks
+ */
+void bench_bsearch()
+{
+    const size_t max_count = (size_t)1 << 26;
+    int * arr = xmalloc(max_count * sizeof(int));
+    int * keys = xmalloc(BENCH_BSEARCH_LOOKUPS * sizeof(int));
+    ptrdiff_t * results = xmalloc(BENCH_BSEARCH_LOOKUPS * sizeof(ptrdiff_t));
+    /* the arranged array has the extra leading element and starts at the cache line boundary */
+    void * layout_block = xmalloc((max_count + 1) * sizeof(int) + 64);
+    int * layout = (int *)(((size_t)layout_block + 63) & ~(size_t)63);
+    size_t count;
+    size_t i;
+
+    for (i = 0; i < max_count; ++i)
+    {
+        arr[i] = (int)(2 * i);
+    }
+
+    /* the characters of the node are every second one of the keys */
+    for (count = 4; count <= 128; count <<= 1)
+    {
+        unsigned char chars[128];
+
+        for (i = 0; i < count; ++i)
+        {
+            chars[i] = (unsigned char)(2 * i);
+        }
+
+        for (i = 0; i < BENCH_BSEARCH_LOOKUPS; ++i)
+        {
+            keys[i] = (int)((i * 2654435761U >> 8) % (2 * count));
+        }
+
+        bench_small_lookups(chars, count, keys);
+    }
+
+    /* from the array that fits L1 cache up to the one that resides in DRAM */
+    for (count = (size_t)1 << 10; count <= max_count; count <<= 4)
+    {
+        bench_lookups(arr, count, keys, layout, results);
+    }
+
+    xfree(layout_block);
+    xfree(results);
+    xfree(keys);
+    xfree(arr);
+}
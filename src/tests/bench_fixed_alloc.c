@@ -0,0 +1,277 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <stdio.h>
+
+/*
+ * node-alike element, similar to the one used by the trees
+ */
+struct BenchNode
+{
+    struct BenchNode * left;
+    struct BenchNode * right;
+    struct BenchNode * parent;
+    int key;
+};
+
+#define FIXED_ALLOC_NS(n)            bnf_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     struct BenchNode
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (16)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_FOREACH_REQUIRED
+#define FIXED_ALLOC_BATCH_REQUIRED
+
+#include <templates/fixed_alloc.h>
+
+/*
+ * same allocator w/clusters carved from the huge page backed regions
+ */
+#define FIXED_ALLOC_NS(n)            bnh_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     struct BenchNode
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (16)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_MMAP_REGIONS
+
+#include <templates/fixed_alloc.h>
+
+/*
+ * frees scattered elements over the whole allocator and allocates them back,
+ * only allocation is measured
+ */
+static void bench_scattered_alloc(size_t total, size_t step, size_t rounds)
+{
+    bnf_allocator allocator;
+    struct BenchNode ** pp;
+    size_t i;
+    size_t r;
+    size_t ops = 0;
+    double seconds = 0.0;
+    char bench_name[64];
+
+    bnf_init_allocator(&allocator);
+    pp = xmalloc(sizeof(struct BenchNode *) * total);
+
+    for (i = 0; i < total; ++i)
+    {
+        pp[i] = bnf_alloc_elem(&allocator);
+    }
+
+    for (r = 0; r < rounds; ++r)
+    {
+        double start;
+
+        for (i = r % step; i < total; i += step)
+        {
+            bnf_free_elem(&allocator, pp[i]);
+        }
+
+        start = ut_bench_time();
+        for (i = r % step; i < total; i += step)
+        {
+            pp[i] = bnf_alloc_elem(&allocator);
+            ++ops;
+        }
+        seconds += ut_bench_time() - start;
+    }
+
+    sprintf(bench_name, "fixed_alloc scattered alloc n=%lu step=%lu", (unsigned long)total, (unsigned long)step);
+    ut_bench_report(bench_name, ops, seconds);
+
+    xfree(pp);
+    bnf_uninit_allocator(&allocator);
+}
+
+static void bench_foreach_cb(void * context, struct BenchNode * e)
+{
+    (void)e;
+    ++*((size_t *)context);
+}
+
+/*
+ * measures status and foreach over the half-filled allocator, one operation per element
+ */
+static void bench_status_foreach(size_t total)
+{
+    bnf_allocator allocator;
+    struct BenchNode ** pp;
+    size_t i;
+    size_t used;
+    size_t allocated;
+    size_t visited = 0;
+    double start;
+    char bench_name[64];
+
+    bnf_init_allocator(&allocator);
+    pp = xmalloc(sizeof(struct BenchNode *) * total);
+
+    for (i = 0; i < total; ++i)
+    {
+        pp[i] = bnf_alloc_elem(&allocator);
+    }
+
+    for (i = 0; i < total; i += 2)
+    {
+        bnf_free_elem(&allocator, pp[i]);
+    }
+
+    start = ut_bench_time();
+    bnf_get_allocator_status(&allocator, &used, &allocated);
+    sprintf(bench_name, "fixed_alloc status n=%lu", (unsigned long)total);
+    ut_bench_report(bench_name, allocated, ut_bench_time() - start);
+
+    start = ut_bench_time();
+    bnf_allocator_foreach(&allocator, &visited, &bench_foreach_cb);
+    sprintf(bench_name, "fixed_alloc foreach n=%lu", (unsigned long)total);
+    ut_bench_report(bench_name, allocated, ut_bench_time() - start);
+
+    if (visited != used)
+    {
+        fprintf(stderr, "error: foreach visited %lu elements of %lu\n", (unsigned long)visited, (unsigned long)used);
+    }
+
+    xfree(pp);
+    bnf_uninit_allocator(&allocator);
+}
+
+/*
+ * measures allocation and disposal of all the elements one by one and in batches
+ */
+static void bench_batch(size_t total)
+{
+    bnf_allocator allocator;
+    struct BenchNode ** pp;
+    size_t i;
+    double start;
+    char bench_name[64];
+
+    pp = xmalloc(sizeof(struct BenchNode *) * total);
+
+    bnf_init_allocator(&allocator);
+    start = ut_bench_time();
+    for (i = 0; i < total; ++i)
+    {
+        pp[i] = bnf_alloc_elem(&allocator);
+    }
+    sprintf(bench_name, "fixed_alloc alloc_elem n=%lu", (unsigned long)total);
+    ut_bench_report(bench_name, total, ut_bench_time() - start);
+
+    start = ut_bench_time();
+    for (i = 0; i < total; ++i)
+    {
+        bnf_free_elem(&allocator, pp[i]);
+    }
+    sprintf(bench_name, "fixed_alloc free_elem n=%lu", (unsigned long)total);
+    ut_bench_report(bench_name, total, ut_bench_time() - start);
+    bnf_uninit_allocator(&allocator);
+
+    bnf_init_allocator(&allocator);
+    start = ut_bench_time();
+    bnf_alloc_elem_n(&allocator, pp, total);
+    sprintf(bench_name, "fixed_alloc alloc_elem_n n=%lu", (unsigned long)total);
+    ut_bench_report(bench_name, total, ut_bench_time() - start);
+
+    start = ut_bench_time();
+    bnf_free_elem_n(&allocator, pp, total);
+    sprintf(bench_name, "fixed_alloc free_elem_n n=%lu", (unsigned long)total);
+    ut_bench_report(bench_name, total, ut_bench_time() - start);
+    bnf_uninit_allocator(&allocator);
+
+    xfree(pp);
+}
+
+/*
+ * links the nodes given in the random order and walks through them
+ */
+static void bench_chase(const char * name, struct BenchNode ** pp, size_t total)
+{
+    struct BenchNode * node;
+    size_t seed = 12345;
+    size_t i;
+    double start;
+    char bench_name[64];
+
+    // shuffle
+    for (i = total - 1; i > 0; --i)
+    {
+        size_t j;
+        struct BenchNode * tmp;
+
+        seed = seed * 1103515245 + 12345;
+        j = (seed >> 16) % (i + 1);
+
+        tmp = pp[i];
+        pp[i] = pp[j];
+        pp[j] = tmp;
+    }
+
+    for (i = 0; i < total; ++i)
+    {
+        pp[i]->left = pp[(i + 1) % total];
+        pp[i]->key = (int)i;
+    }
+
+    node = pp[0];
+    start = ut_bench_time();
+    for (i = 0; i < total; ++i)
+    {
+        node = node->left;
+    }
+    sprintf(bench_name, "%s n=%lu", name, (unsigned long)total);
+    ut_bench_report(bench_name, total, ut_bench_time() - start);
+
+    if (node != pp[0])
+    {
+        fprintf(stderr, "error: chase ended at node %d\n", node->key);
+    }
+}
+
+/*
+ * measures random nodes access for the clusters allocated by malloc and carved from mmap regions
+ */
+static void bench_random_access(size_t total)
+{
+    bnf_allocator allocator;
+    bnh_allocator mmap_allocator;
+    struct BenchNode ** pp;
+    size_t i;
+
+    pp = xmalloc(sizeof(struct BenchNode *) * total);
+
+    bnf_init_allocator(&allocator);
+    for (i = 0; i < total; ++i)
+    {
+        pp[i] = bnf_alloc_elem(&allocator);
+    }
+    bench_chase("fixed_alloc random access", pp, total);
+    bnf_uninit_allocator(&allocator);
+
+    bnh_init_allocator(&mmap_allocator);
+    for (i = 0; i < total; ++i)
+    {
+        pp[i] = bnh_alloc_elem(&mmap_allocator);
+    }
+    bench_chase("fixed_alloc random access w/mmap", pp, total);
+    bnh_uninit_allocator(&mmap_allocator);
+
+    xfree(pp);
+}
+
+/*
+ * function that launches benchmarks
+ */
+void bench_fixed_alloc()
+{
+    bench_scattered_alloc(1 << 16, 64, 8);
+    bench_scattered_alloc(1 << 20, 1024, 8);
+    bench_scattered_alloc(1 << 22, 4096, 8);
+    bench_status_foreach(1 << 22);
+    bench_batch(1 << 22);
+    bench_random_access(1 << 20);
+    bench_random_access(1 << 23);
+}
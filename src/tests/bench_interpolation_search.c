@@ -0,0 +1,129 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * searches over the sorted arrays of 64-bit keys
+ */
+#define BSEARCH_NS(name)     bib_##name
+#define BSEARCH_ARRAY_TYPE   const int64_t *
+#define BSEARCH_KEY_TYPE     int64_t
+#define BSEARCH_3W_COMPARE(array, index, key) ((key > array[index]) - (key < array[index]))
+#define BSEARCH_BOUNDS_REQUIRED
+#include <templates/bsearch.h>
+
+#define INTERPOLATION_SEARCH_NS(name)       bii_##name
+#define INTERPOLATION_SEARCH_ARRAY_TYPE     const int64_t *
+#define INTERPOLATION_SEARCH_KEY_TYPE       int64_t
+#define INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) (array[index])
+#include <templates/interpolation_search.h>
+
+/*
+ * the same searches that count the elements they read
+ */
+static size_t g_bench_reads_count;
+
+#define BSEARCH_NS(name)     bcb_##name
+#define BSEARCH_ARRAY_TYPE   const int64_t *
+#define BSEARCH_KEY_TYPE     int64_t
+#define BSEARCH_3W_COMPARE(array, index, key) \
+    (++g_bench_reads_count, (key > array[index]) - (key < array[index]))
+#define BSEARCH_BOUNDS_REQUIRED
+#include <templates/bsearch.h>
+
+#define INTERPOLATION_SEARCH_NS(name)       bci_##name
+#define INTERPOLATION_SEARCH_ARRAY_TYPE     const int64_t *
+#define INTERPOLATION_SEARCH_KEY_TYPE       int64_t
+#define INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) (++g_bench_reads_count, array[index])
+#include <templates/interpolation_search.h>
+
+#define BENCH_INTERPOLATION_LOOKUPS   (1 << 20)
+
+/*
+ * looks up the keys, then repeats the lookups counting the elements read
+ */
+#define BENCH_INTERPOLATION(name, expr, counted_expr) \
+    { \
+        size_t i; \
+        double start = ut_bench_time(); \
+        for (i = 0; i < BENCH_INTERPOLATION_LOOKUPS; ++i) \
+        { \
+            const int64_t key = keys[i]; \
+            sum += (size_t)(expr); \
+        } \
+        start = ut_bench_time() - start; \
+        g_bench_reads_count = 0; \
+        for (i = 0; i < BENCH_INTERPOLATION_LOOKUPS; ++i) \
+        { \
+            const int64_t key = keys[i]; \
+            sum += (size_t)(counted_expr); \
+        } \
+        sprintf(bench_name, "%s, %s, reads/op=%.1f", name, distribution, \
+                (double)g_bench_reads_count / BENCH_INTERPOLATION_LOOKUPS); \
+        ut_bench_report(bench_name, BENCH_INTERPOLATION_LOOKUPS, start); \
+    }
+
+static volatile size_t g_bench_interpolation_sink;
+
+static void bench_lookups(const char * distribution, const int64_t * arr, size_t count, int64_t * keys)
+{
+    char bench_name[96];
+    unsigned int seed = 12345;
+    size_t sum = 0;
+    size_t i;
+
+    // the present keys and the keys that fall between the elements
+    for (i = 0; i < BENCH_INTERPOLATION_LOOKUPS; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        keys[i] = arr[(seed >> 4) % count] + (int64_t)(i & 1);
+    }
+
+    BENCH_INTERPOLATION("lower_bound", bib_lower_bound(arr, (int)count, key),
+                        bcb_lower_bound(arr, (int)count, key));
+    BENCH_INTERPOLATION("interpolation_lower_bound", bii_interpolation_lower_bound(arr, count, key),
+                        bci_interpolation_lower_bound(arr, count, key));
+
+    g_bench_interpolation_sink = sum;
+}
+
+/*
+ * function that launches benchmarks
+ */
+void bench_interpolation_search()
+{
+    const size_t count = (size_t)1 << 22;
+    int64_t * arr = xmalloc(count * sizeof(int64_t));
+    int64_t * keys = xmalloc(BENCH_INTERPOLATION_LOOKUPS * sizeof(int64_t));
+    unsigned int seed = 54321;
+    size_t i;
+
+    /* timestamps that come with the random intervals */
+    arr[0] = 0;
+    for (i = 1; i < count; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        arr[i] = arr[i - 1] + 1 + (int64_t)((seed >> 4) % 2000);
+    }
+    bench_lookups("uniform", arr, count, keys);
+
+    /* quadratic growth */
+    for (i = 0; i < count; ++i)
+    {
+        arr[i] = (int64_t)i * (int64_t)i;
+    }
+    bench_lookups("skewed", arr, count, keys);
+
+    /* the outlier makes the interpolation estimate every position close to the beginning of the range */
+    for (i = 0; i < count - 1; ++i)
+    {
+        arr[i] = (int64_t)i;
+    }
+    arr[count - 1] = INT64_MAX / 2;
+    bench_lookups("adversarial", arr, count, keys);
+
+    xfree(keys);
+    xfree(arr);
+}
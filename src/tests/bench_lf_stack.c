@@ -0,0 +1,154 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <pthread.h>
+#include <stdio.h>
+
+/*
+ * lock-free stack of the work items
+ */
+#define LF_STACK_NS(n)                  blf_##n
+#define LF_STACK_ELEMENT_TYPE           size_t
+#define LF_STACK_XMALLOC                xmalloc
+#define LF_STACK_XFREE                  xfree
+
+#include <templates/lf_stack.h>
+
+/*
+ * stack guarded by the global lock, the baseline
+ */
+#define STACK_NS(name)                  blk_##name
+#define STACK_ELEMENT_TYPE              size_t
+#define STACK_XREALLOC                  xrealloc
+#define STACK_XFREE                     xfree
+#define STACK_GROW_FACTOR               2
+
+#include <templates/stack.h>
+
+#define BENCH_LF_MAX_THREADS    (16)
+#define BENCH_LF_BATCH_SIZE     (64)
+
+struct LfBenchContext
+{
+    blf_lf_stack        stack;
+    blk_stack           locked_stack;
+    pthread_mutex_t     lock;
+    size_t              rounds;
+    size_t              sum;
+};
+
+/*
+ * every round pushes the batch of items and pops the same count of items, which may be pushed by the other thread
+ */
+static void * bench_lf_thread_proc(void * p)
+{
+    struct LfBenchContext * context = p;
+    size_t sum = 0;
+    size_t r;
+    size_t i;
+    size_t n;
+
+    for (r = 0; r < context->rounds; ++r)
+    {
+        for (i = 0; i < BENCH_LF_BATCH_SIZE; ++i)
+        {
+            blf_lf_stack_push(&context->stack, i);
+        }
+
+        for (i = 0; i < BENCH_LF_BATCH_SIZE; ++i)
+        {
+            if (blf_lf_stack_pop(&context->stack, &n))
+            {
+                sum += n;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&context->lock);
+    context->sum += sum;
+    pthread_mutex_unlock(&context->lock);
+    return NULL;
+}
+
+static void * bench_locked_thread_proc(void * p)
+{
+    struct LfBenchContext * context = p;
+    size_t sum = 0;
+    size_t r;
+    size_t i;
+
+    for (r = 0; r < context->rounds; ++r)
+    {
+        for (i = 0; i < BENCH_LF_BATCH_SIZE; ++i)
+        {
+            pthread_mutex_lock(&context->lock);
+            blk_stack_push(&context->locked_stack, i);
+            pthread_mutex_unlock(&context->lock);
+        }
+
+        for (i = 0; i < BENCH_LF_BATCH_SIZE; ++i)
+        {
+            pthread_mutex_lock(&context->lock);
+            if (!blk_stack_empty(&context->locked_stack))
+            {
+                sum += blk_stack_pop(&context->locked_stack);
+            }
+            pthread_mutex_unlock(&context->lock);
+        }
+    }
+
+    pthread_mutex_lock(&context->lock);
+    context->sum += sum;
+    pthread_mutex_unlock(&context->lock);
+    return NULL;
+}
+
+/*
+ * runs push/pop rounds on the given count of threads, one operation is either push or pop
+ */
+static void bench_threads(const char * name, void * (* thread_proc)(void *), size_t threads_count, size_t rounds)
+{
+    struct LfBenchContext context;
+    pthread_t threads[BENCH_LF_MAX_THREADS];
+    size_t i;
+    double start;
+    char bench_name[64];
+
+    blf_lf_stack_init(&context.stack);
+    blk_stack_init(&context.locked_stack);
+    pthread_mutex_init(&context.lock, NULL);
+    context.rounds = rounds;
+    context.sum = 0;
+
+    start = ut_bench_time();
+    for (i = 0; i < threads_count; ++i)
+    {
+        pthread_create(&threads[i], NULL, thread_proc, &context);
+    }
+
+    for (i = 0; i < threads_count; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    sprintf(bench_name, "%s threads=%lu", name, (unsigned long)threads_count);
+    ut_bench_report(bench_name, 2 * BENCH_LF_BATCH_SIZE * rounds * threads_count, ut_bench_time() - start);
+
+    pthread_mutex_destroy(&context.lock);
+    blk_stack_uninit(&context.locked_stack);
+    blf_lf_stack_uninit(&context.stack);
+}
+
+/*
+ * function that launches benchmarks
+ */
+void bench_lf_stack()
+{
+    size_t threads_count;
+
+    for (threads_count = 1; threads_count <= 8; threads_count *= 2)
+    {
+        bench_threads("locked stack push/pop", &bench_locked_thread_proc, threads_count, 16384);
+        bench_threads("lf_stack push/pop", &bench_lf_thread_proc, threads_count, 16384);
+    }
+}
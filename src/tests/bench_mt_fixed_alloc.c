@@ -0,0 +1,160 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <pthread.h>
+#include <stdio.h>
+
+/*
+ * node-alike element, similar to the one used by the trees
+ */
+struct MtBenchNode
+{
+    struct MtBenchNode * left;
+    struct MtBenchNode * right;
+    struct MtBenchNode * parent;
+    int key;
+};
+
+#define MT_FIXED_ALLOC_NS(n)            bnm_##n
+#define MT_FIXED_ALLOC_ELEMENT_TYPE     struct MtBenchNode
+#define MT_FIXED_ALLOC_XMALLOC          xmalloc
+#define MT_FIXED_ALLOC_XFREE            xfree
+#define MT_FIXED_ALLOC_INITIAL_CHUNK_SIZE (16)
+
+#include <templates/mt_fixed_alloc.h>
+
+/*
+ * single-threaded allocator guarded by the global lock, the baseline
+ */
+#define FIXED_ALLOC_NS(n)            bnl_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     struct MtBenchNode
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (16)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+
+#include <templates/fixed_alloc.h>
+
+#define BENCH_MT_MAX_THREADS    (16)
+#define BENCH_MT_BATCH_SIZE     (256)
+
+struct MtBenchContext
+{
+    bnm_allocator *     allocator;
+    bnl_allocator *     locked_allocator;
+    pthread_mutex_t     lock;
+    size_t              rounds;
+};
+
+/*
+ * every round allocates the batch of elements and frees them in reverse order
+ */
+static void * bench_mt_thread_proc(void * p)
+{
+    struct MtBenchContext * context = p;
+    struct MtBenchNode * batch[BENCH_MT_BATCH_SIZE];
+    bnm_cache cache;
+    size_t r;
+    size_t i;
+
+    bnm_init_cache(context->allocator, &cache);
+
+    for (r = 0; r < context->rounds; ++r)
+    {
+        for (i = 0; i < BENCH_MT_BATCH_SIZE; ++i)
+        {
+            batch[i] = bnm_alloc_elem(&cache);
+            batch[i]->key = (int)i;
+        }
+
+        for (i = BENCH_MT_BATCH_SIZE; i > 0; --i)
+        {
+            bnm_free_elem(&cache, batch[i - 1]);
+        }
+    }
+
+    bnm_uninit_cache(&cache);
+    return NULL;
+}
+
+static void * bench_locked_thread_proc(void * p)
+{
+    struct MtBenchContext * context = p;
+    struct MtBenchNode * batch[BENCH_MT_BATCH_SIZE];
+    size_t r;
+    size_t i;
+
+    for (r = 0; r < context->rounds; ++r)
+    {
+        for (i = 0; i < BENCH_MT_BATCH_SIZE; ++i)
+        {
+            pthread_mutex_lock(&context->lock);
+            batch[i] = bnl_alloc_elem(context->locked_allocator);
+            pthread_mutex_unlock(&context->lock);
+            batch[i]->key = (int)i;
+        }
+
+        for (i = BENCH_MT_BATCH_SIZE; i > 0; --i)
+        {
+            pthread_mutex_lock(&context->lock);
+            bnl_free_elem(context->locked_allocator, batch[i - 1]);
+            pthread_mutex_unlock(&context->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * runs alloc/free rounds on the given count of threads, one operation is either alloc or free
+ */
+static void bench_threads(const char * name, void * (* thread_proc)(void *), size_t threads_count, size_t rounds)
+{
+    bnm_allocator allocator;
+    bnl_allocator locked_allocator;
+    struct MtBenchContext context;
+    pthread_t threads[BENCH_MT_MAX_THREADS];
+    size_t i;
+    double start;
+    char bench_name[64];
+
+    bnm_init_allocator(&allocator);
+    bnl_init_allocator(&locked_allocator);
+    context.allocator = &allocator;
+    context.locked_allocator = &locked_allocator;
+    context.rounds = rounds;
+    pthread_mutex_init(&context.lock, NULL);
+
+    start = ut_bench_time();
+    for (i = 0; i < threads_count; ++i)
+    {
+        pthread_create(&threads[i], NULL, thread_proc, &context);
+    }
+
+    for (i = 0; i < threads_count; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    sprintf(bench_name, "%s threads=%lu", name, (unsigned long)threads_count);
+    ut_bench_report(bench_name, 2 * BENCH_MT_BATCH_SIZE * rounds * threads_count, ut_bench_time() - start);
+
+    pthread_mutex_destroy(&context.lock);
+    bnl_uninit_allocator(&locked_allocator);
+    bnm_uninit_allocator(&allocator);
+}
+
+/*
+ * function that launches benchmarks
+ */
+void bench_mt_fixed_alloc()
+{
+    size_t threads_count;
+
+    for (threads_count = 1; threads_count <= 8; threads_count *= 2)
+    {
+        bench_threads("locked fixed_alloc alloc/free", &bench_locked_thread_proc, threads_count, 4096);
+        bench_threads("mt_fixed_alloc alloc/free", &bench_mt_thread_proc, threads_count, 4096);
+    }
+}
@@ -0,0 +1,91 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <stdio.h>
+
+/*
+ * stacks of the node-alike elements, similar to the ones used as traversal work lists
+ */
+struct StackBenchItem
+{
+    void *  node;
+    size_t  depth;
+};
+
+#define STACK_NS(name)                  bsa_##name
+#define STACK_ELEMENT_TYPE              struct StackBenchItem
+#define STACK_XREALLOC                  xrealloc
+#define STACK_XFREE                     xfree
+#include <templates/stack.h>
+
+#define STACK_NS(name)                  bsg_##name
+#define STACK_ELEMENT_TYPE              struct StackBenchItem
+#define STACK_XREALLOC                  xrealloc
+#define STACK_XFREE                     xfree
+#define STACK_GROW_FACTOR               2
+#include <templates/stack.h>
+
+#define SEGMENTED_STACK_NS(name)        bss_##name
+#define SEGMENTED_STACK_ELEMENT_TYPE    struct StackBenchItem
+#define SEGMENTED_STACK_XMALLOC         xmalloc
+#define SEGMENTED_STACK_XFREE           xfree
+#include <templates/segmented_stack.h>
+
+#define BENCH_STACK_BATCH_SIZE  (256)
+
+/*
+ * pushes the given count of elements by batches, reports average time of the push and
+ * the time of the slowest batch, then pops all the elements
+ */
+#define BENCH_STACK(prefix, stack_type, name, count) \
+    { \
+        stack_type stack; \
+        struct StackBenchItem item = { NULL, 0 }; \
+        double worst = 0.0; \
+        double start; \
+        size_t i; \
+        size_t j; \
+        prefix##_init(&stack); \
+        start = ut_bench_time(); \
+        for (i = 0; i < (count); i += BENCH_STACK_BATCH_SIZE) \
+        { \
+            double batch_start = ut_bench_time(); \
+            for (j = 0; j < BENCH_STACK_BATCH_SIZE; ++j) \
+            { \
+                item.depth = i + j; \
+                prefix##_push(&stack, item); \
+            } \
+            batch_start = ut_bench_time() - batch_start; \
+            worst = (batch_start > worst) ? batch_start : worst; \
+        } \
+        sprintf(bench_name, "%s push", name); \
+        ut_bench_report(bench_name, (count), ut_bench_time() - start); \
+        sprintf(bench_name, "%s push, slowest batch", name); \
+        ut_bench_report(bench_name, BENCH_STACK_BATCH_SIZE, worst); \
+        start = ut_bench_time(); \
+        for (i = 0; i < (count); ++i) \
+        { \
+            sum += prefix##_pop(&stack).depth; \
+        } \
+        sprintf(bench_name, "%s pop", name); \
+        ut_bench_report(bench_name, (count), ut_bench_time() - start); \
+        prefix##_uninit(&stack); \
+    }
+
+static volatile size_t g_bench_stack_sink;
+
+/*
+ * function that launches benchmarks
+ */
+void bench_stack()
+{
+    char bench_name[64];
+    size_t sum = 0;
+    const size_t count = 4 * 1024 * 1024;
+
+    BENCH_STACK(bsa_stack, bsa_stack, "stack, additive growth", count);
+    BENCH_STACK(bsg_stack, bsg_stack, "stack, geometric growth", count);
+    BENCH_STACK(bss_segmented_stack, bss_segmented_stack, "segmented stack", count);
+
+    g_bench_stack_sink = sum;
+}
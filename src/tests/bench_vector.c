@@ -0,0 +1,237 @@
+#include <utilities/ut/ut_bench.h>
+#include <utilities/alloc.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_VECTOR_PREALLOC_SIZE  (64)
+
+/*
+ * vector w/preallocated elements, elements pointer refers to the active storage
+ */
+#define VECTOR_NS(name)             bsv_##name
+#define VECTOR_ELEMENT_TYPE         int
+#define VECTOR_XREALLOC             xrealloc
+#define VECTOR_XFREE                xfree
+#define VECTOR_PREALLOCATED_SIZE    BENCH_VECTOR_PREALLOC_SIZE
+#define VECTOR_GROW_SIZE            (64)
+#define VECTOR_GROW_FACTOR          2
+#include <templates/vector.h>
+
+/*
+ * vector w/o preallocated elements
+ */
+#define VECTOR_NS(name)             bhv_##name
+#define VECTOR_ELEMENT_TYPE         int
+#define VECTOR_XREALLOC             xrealloc
+#define VECTOR_XFREE                xfree
+#define VECTOR_GROW_SIZE            (64)
+#define VECTOR_GROW_FACTOR          2
+#include <templates/vector.h>
+
+/*
+ * vectors of integers sorted by merge sort, radix sort and parallel merge sort
+ */
+#define BENCH_VECTOR_INT_COMPARE(left, right) (((left) > (right)) - ((left) < (right)))
+
+#define VECTOR_NS(name)             bsr_##name
+#define VECTOR_ELEMENT_TYPE         int
+#define VECTOR_XREALLOC             xrealloc
+#define VECTOR_XFREE                xfree
+#define VECTOR_3W_COMPARE           BENCH_VECTOR_INT_COMPARE
+#include <templates/vector.h>
+
+#define VECTOR_NS(name)             brx_##name
+#define VECTOR_ELEMENT_TYPE         int
+#define VECTOR_XREALLOC             xrealloc
+#define VECTOR_XFREE                xfree
+#define VECTOR_3W_COMPARE           BENCH_VECTOR_INT_COMPARE
+#define VECTOR_RADIX_KEY(element)   ((unsigned int)(element) ^ 0x80000000U)
+#include <templates/vector.h>
+
+#define VECTOR_NS(name)             bpr_##name
+#define VECTOR_ELEMENT_TYPE         int
+#define VECTOR_XREALLOC             xrealloc
+#define VECTOR_XFREE                xfree
+#define VECTOR_3W_COMPARE           BENCH_VECTOR_INT_COMPARE
+#define VECTOR_SORT_THREADS         (4)
+#include <templates/vector.h>
+
+/*
+ * the former layout of the vector w/preallocated elements, the baseline:
+ * the preallocated array is selected by the flag checked on each operation
+ */
+struct BenchFlaggedVector
+{
+    int     prealloc_elements[BENCH_VECTOR_PREALLOC_SIZE];
+    bool    prealloc_used;
+    int *   elements;
+    size_t  allocated;
+    size_t  size;
+};
+
+static void bfv_vector_init(struct BenchFlaggedVector * vector)
+{
+    vector->prealloc_used = true;
+    vector->elements = NULL;
+    vector->allocated = 0;
+    vector->size = 0;
+}
+
+static void bfv_vector_uninit(struct BenchFlaggedVector * vector)
+{
+    xfree(vector->elements);
+}
+
+static void bfv_vector_push_back(struct BenchFlaggedVector * vector, int element)
+{
+    if (vector->prealloc_used)
+    {
+        if (vector->size < BENCH_VECTOR_PREALLOC_SIZE)
+        {
+            vector->prealloc_elements[vector->size++] = element;
+            return;
+        }
+
+        vector->allocated = 2 * BENCH_VECTOR_PREALLOC_SIZE;
+        vector->elements = xrealloc(0, vector->allocated * sizeof(int));
+        memcpy(vector->elements, vector->prealloc_elements, vector->size * sizeof(int));
+        vector->prealloc_used = false;
+    }
+    else if (vector->size == vector->allocated)
+    {
+        vector->allocated *= 2;
+        vector->elements = xrealloc(vector->elements, vector->allocated * sizeof(int));
+    }
+
+    vector->elements[vector->size++] = element;
+}
+
+static inline int * bfv_vector_data(struct BenchFlaggedVector * vector)
+{
+    return vector->prealloc_used ? vector->prealloc_elements : vector->elements;
+}
+
+/*
+ * each round creates the vector, pushes the given count of elements, sums them up and destroys the vector
+ */
+#define BENCH_VECTOR_ROUND(prefix, vector_type, count, sum) \
+    { \
+        vector_type vector; \
+        size_t k; \
+        prefix##_vector_init(&vector); \
+        for (k = 0; k < (count); ++k) \
+        { \
+            prefix##_vector_push_back(&vector, (int)k); \
+        } \
+        for (k = 0; k < (count); ++k) \
+        { \
+            sum += prefix##_vector_data(&vector)[k]; \
+        } \
+        prefix##_vector_uninit(&vector); \
+    }
+
+static volatile size_t g_bench_vector_sink;
+
+static void bench_small_vectors(size_t count, size_t rounds)
+{
+    char bench_name[64];
+    size_t sum = 0;
+    size_t r;
+    double start;
+
+    start = ut_bench_time();
+    for (r = 0; r < rounds; ++r)
+    {
+        BENCH_VECTOR_ROUND(bfv, struct BenchFlaggedVector, count + (r & 1), sum);
+    }
+    sprintf(bench_name, "flagged prealloc vector, size=%lu", (unsigned long)count);
+    ut_bench_report(bench_name, rounds, ut_bench_time() - start);
+
+    start = ut_bench_time();
+    for (r = 0; r < rounds; ++r)
+    {
+        BENCH_VECTOR_ROUND(bsv, bsv_vector, count + (r & 1), sum);
+    }
+    sprintf(bench_name, "prealloc vector, size=%lu", (unsigned long)count);
+    ut_bench_report(bench_name, rounds, ut_bench_time() - start);
+
+    start = ut_bench_time();
+    for (r = 0; r < rounds; ++r)
+    {
+        BENCH_VECTOR_ROUND(bhv, bhv_vector, count + (r & 1), sum);
+    }
+    sprintf(bench_name, "heap vector, size=%lu", (unsigned long)count);
+    ut_bench_report(bench_name, rounds, ut_bench_time() - start);
+
+    g_bench_vector_sink = sum;
+}
+
+static int bench_int_compare(const void * left, const void * right)
+{
+    return BENCH_VECTOR_INT_COMPARE(*(const int *)left, *(const int *)right);
+}
+
+/*
+ * sorts the vector of the given count of the pseudo-random integers, one operation is a sorted element
+ */
+#define BENCH_VECTOR_SORT(prefix, name, source, count) \
+    { \
+        prefix##_vector vector; \
+        double start; \
+        prefix##_vector_init(&vector); \
+        prefix##_vector_append_n(&vector, source, count); \
+        start = ut_bench_time(); \
+        prefix##_vector_sort(&vector); \
+        sprintf(bench_name, "%s, size=%lu", name, (unsigned long)(count)); \
+        ut_bench_report(bench_name, count, ut_bench_time() - start); \
+        prefix##_vector_uninit(&vector); \
+    }
+
+static void bench_sort(size_t count)
+{
+    char bench_name[64];
+    int * source = xmalloc(count * sizeof(int));
+    int * elements = xmalloc(count * sizeof(int));
+    unsigned int seed = 12345;
+    double start;
+    size_t i;
+
+    for (i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        source[i] = (int)(seed ^ (seed >> 15));
+    }
+
+    memcpy(elements, source, count * sizeof(int));
+    start = ut_bench_time();
+    qsort(elements, count, sizeof(int), &bench_int_compare);
+    sprintf(bench_name, "qsort, size=%lu", (unsigned long)count);
+    ut_bench_report(bench_name, count, ut_bench_time() - start);
+
+    BENCH_VECTOR_SORT(bsr, "vector_sort merge", source, count);
+    BENCH_VECTOR_SORT(brx, "vector_sort radix", source, count);
+    BENCH_VECTOR_SORT(bpr, "vector_sort 4 threads", source, count);
+
+    xfree(elements);
+    xfree(source);
+}
+
+/*
+ * function that launches benchmarks
+ */
+void bench_vector()
+{
+    static const size_t sizes[] = { 0, 1, 4, 16, 32, 63 };
+    size_t i;
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        bench_small_vectors(sizes[i], 1000000);
+    }
+
+    bench_sort(100000);
+    bench_sort(4000000);
+}
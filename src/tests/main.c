@@ -2,25 +2,70 @@
 #include <utilities/alloc.h>
 #include <utilities/ut/ut.h>
 
+#include <string.h>
+
 // test cases entry points
+void test_bitops();
 void test_fixed_alloc();
+void test_mt_fixed_alloc();
 void test_bsearch();
+void test_eytzinger();
+void test_simd_search();
+void test_interpolation_search();
 void test_stack();
+void test_lf_stack();
 void test_vector();
+void test_mmap_vector();
 void test_avl_tree();
 void test_rb_tree();
 void test_lexical_tree();
 
-int main()
+// benchmarks entry points
+void bench_fixed_alloc();
+void bench_mt_fixed_alloc();
+void bench_vector();
+void bench_stack();
+void bench_lf_stack();
+void bench_bsearch();
+void bench_interpolation_search();
+
+static void run_benchmarks()
+{
+    fprintf(stderr, "benchmarks started\n");
+
+    bench_fixed_alloc();
+    bench_mt_fixed_alloc();
+    bench_vector();
+    bench_stack();
+    bench_lf_stack();
+    bench_bsearch();
+    bench_interpolation_search();
+}
+
+int main(int argc, char ** argv)
 {
     int result = 0;
+
+    if ((argc > 1) && (0 == strcmp(argv[1], "--bench")))
+    {
+        run_benchmarks();
+        return result;
+    }
+
     fprintf(stderr, "tests started\n");
 
     /* tests goes here */
+    test_bitops();
     test_fixed_alloc();
+    test_mt_fixed_alloc();
     test_bsearch();
+    test_eytzinger();
+    test_simd_search();
+    test_interpolation_search();
     test_vector();
+    test_mmap_vector();
     test_stack();
+    test_lf_stack();
     test_avl_tree();
     test_rb_tree();
     test_lexical_tree();
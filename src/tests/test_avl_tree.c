@@ -66,6 +66,7 @@ static void test_simple_avl_tree()
 #define AVL_TREE_IS_VALID_TREE_REQUIRED
 #define AVL_TREE_COUNT_REQUIRED
 #define AVL_TREE_FOREACH_REQUIRED
+#define AVL_TREE_CLEAR_REQUIRED
 
 #include <templates/avl_tree.h>
 
@@ -160,6 +161,30 @@ static void test_avl_tree2()
         UT_VERIFY(tree.count = nodesLeft);
     }
 
+    /* test tree clear */
+    {
+        const void * cluster = tree.allocator.cluster;
+
+        int_tree_clear(&tree);
+        UT_VERIFY((tree.count == 0) && int_is_valid_tree(&tree));
+
+        for (i = 0; i < total; ++i)
+        {
+            UT_VERIFY_SILENT(int_find_node(&tree, arr[i]) == NULL);
+        }
+
+        /* memory is reused */
+        for (i = 0; i < total; ++i)
+        {
+            bool found;
+            int_node * n = int_add_node_ext(&tree, arr[i], &found);
+            UT_VERIFY_SILENT((n != NULL) && (n->key == arr[i]) && !found);
+        }
+
+        UT_VERIFY((tree.count == total) && int_is_valid_tree(&tree));
+        UT_VERIFY(tree.allocator.cluster == cluster);
+    }
+
     int_uninit_tree(&tree);
     xfree(arr);
     UT_END();
@@ -0,0 +1,68 @@
+#include <utilities/ut/ut.h>
+
+#include <templates/bitops.h>
+
+static void bitops_test1()
+{
+    size_t i;
+    const size_t width = sizeof(unsigned long) * CHAR_BIT;
+
+    UT_BEGIN("bitops test #1");
+
+    UT_VERIFY(bitops_popcount(0) == 0);
+    UT_VERIFY(bitops_popcount(ULONG_MAX) == width);
+    UT_VERIFY(bitops_popcount(0xF0F0UL) == 8);
+
+    UT_VERIFY(bitops_ctz(1) == 0);
+    UT_VERIFY(bitops_ctz(0xF0F0UL) == 4);
+    UT_VERIFY(bitops_ctz(ULONG_MAX) == 0);
+
+    for (i = 0; i < width; ++i)
+    {
+        unsigned long bit = 1UL << i;
+
+        UT_VERIFY_SILENT(bitops_ctz(bit) == i);
+        UT_VERIFY_SILENT(bitops_ctz(ULONG_MAX << i) == i);
+        UT_VERIFY_SILENT(bitops_popcount(bit) == 1);
+        UT_VERIFY_SILENT(bitops_popcount(ULONG_MAX << i) == width - i);
+    }
+
+    UT_END();
+}
+
+static void bitops_test2()
+{
+    const unsigned long patterns[] = { 1UL, 2UL, 3UL, 0x80UL, 0xF0F0UL, 0x12345678UL, 0x80000000UL,
+                                       0xFFFFFFFFUL, ULONG_MAX, ULONG_MAX << 7, ULONG_MAX / 3, ULONG_MAX / 5 };
+    size_t i;
+    size_t shift;
+    const size_t width = sizeof(unsigned long) * CHAR_BIT;
+
+    UT_BEGIN("bitops test #2: generic implementation");
+
+    UT_VERIFY(bitops_internal_popcount_generic(0) == 0);
+
+    /* the generic code shall agree with the intrinsics over the patterns moved to every bit position */
+    for (i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i)
+    {
+        for (shift = 0; shift < width; ++shift)
+        {
+            unsigned long x = patterns[i] << shift;
+
+            if (0 != x)
+            {
+                UT_VERIFY_SILENT(bitops_internal_ctz_generic(x) == bitops_ctz(x));
+            }
+
+            UT_VERIFY_SILENT(bitops_internal_popcount_generic(x) == bitops_popcount(x));
+        }
+    }
+
+    UT_END();
+}
+
+void test_bitops()
+{
+    bitops_test1();
+    bitops_test2();
+}
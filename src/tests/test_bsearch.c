@@ -8,6 +8,19 @@
 #define BSEARCH_ARRAY_TYPE   int *
 #define BSEARCH_KEY_TYPE     int
 #define BSEARCH_3W_COMPARE(array, index, key) (key - array[index])
+#define BSEARCH_PREFETCH(array, index) __builtin_prefetch(&array[index])
+#define BSEARCH_BOUNDS_REQUIRED
+#define BSEARCH_BRANCHLESS_REQUIRED
+#define BSEARCH_BATCH_REQUIRED
+#include <templates/bsearch.h>
+
+#define BSEARCH_NS(name)     smd_##name
+#define BSEARCH_ARRAY_TYPE   int *
+#define BSEARCH_KEY_TYPE     int
+#define BSEARCH_3W_COMPARE(array, index, key) (key - array[index])
+#define BSEARCH_SIMD_THRESHOLD (64)
+#define BSEARCH_BOUNDS_REQUIRED
+#define BSEARCH_BRANCHLESS_REQUIRED
 #include <templates/bsearch.h>
 
 static void bsearch_test1()
@@ -35,7 +48,129 @@ static void bsearch_test1()
     UT_END();
 }
 
+static void bsearch_test2()
+{
+    int arr[] = { 10, 20, 20, 20, 30, 40, 40, 50 };
+    const int count = sizeof(arr) / sizeof(arr[0]);
+    int first;
+    int last;
+
+    UT_BEGIN("bsearch test #2: bounds");
+
+    UT_VERIFY((0 == int_lower_bound(arr, count, 10)) && (1 == int_upper_bound(arr, count, 10)));
+    UT_VERIFY((1 == int_lower_bound(arr, count, 20)) && (4 == int_upper_bound(arr, count, 20)));
+    UT_VERIFY((5 == int_lower_bound(arr, count, 40)) && (7 == int_upper_bound(arr, count, 40)));
+    UT_VERIFY((0 == int_lower_bound(arr, count, 5)) && (0 == int_upper_bound(arr, count, 5)));
+    UT_VERIFY((4 == int_lower_bound(arr, count, 25)) && (4 == int_upper_bound(arr, count, 25)));
+    UT_VERIFY((8 == int_lower_bound(arr, count, 55)) && (8 == int_upper_bound(arr, count, 55)));
+    UT_VERIFY((0 == int_lower_bound(arr, 0, 10)) && (0 == int_upper_bound(arr, 0, 10)));
+
+    int_equal_range(arr, count, 20, &first, &last);
+    UT_VERIFY((first == 1) && (last == 4));
+    int_equal_range(arr, count, 50, &first, &last);
+    UT_VERIFY((first == 7) && (last == 8));
+    int_equal_range(arr, count, 35, &first, &last);
+    UT_VERIFY((first == 5) && (last == 5));
+    int_equal_range(arr, 0, 35, &first, &last);
+    UT_VERIFY((first == 0) && (last == 0));
+
+    UT_END();
+}
+
+static void bsearch_test3()
+{
+    int arr[200];
+    int count;
+    int key;
+    int i;
+
+    UT_BEGIN("bsearch test #3: bounds over arrays of various sizes");
+
+    for (count = 0; count <= 200; count += 7)
+    {
+        // sorted array with runs of the equal elements
+        for (i = 0; i < count; ++i)
+        {
+            arr[i] = 2 * (i / 3 + i / 5);
+        }
+
+        for (key = -1; key <= (count > 0 ? arr[count - 1] + 1 : 0); ++key)
+        {
+            int lower = 0;
+            int upper;
+            int first;
+            int last;
+
+            while ((lower < count) && (arr[lower] < key))
+            {
+                ++lower;
+            }
+
+            for (upper = lower; (upper < count) && (arr[upper] == key); ++upper)
+            {
+            }
+
+            int_equal_range(arr, count, key, &first, &last);
+
+            UT_VERIFY_SILENT(lower == int_lower_bound(arr, count, key));
+            UT_VERIFY_SILENT(upper == int_upper_bound(arr, count, key));
+            UT_VERIFY_SILENT((lower == first) && (upper == last));
+            UT_VERIFY_SILENT((size_t)lower == int_branchless_lower_bound(arr, (size_t)count, key));
+            UT_VERIFY_SILENT(((lower < upper) ? lower : ~lower) == int_branchless_binary_search(arr, (size_t)count, key));
+
+            // the arrays below the threshold are searched by means of simd_search.h
+            UT_VERIFY_SILENT(lower == smd_lower_bound(arr, count, key));
+            UT_VERIFY_SILENT((size_t)lower == smd_branchless_lower_bound(arr, (size_t)count, key));
+            UT_VERIFY_SILENT(lower < upper ? (arr[smd_binary_search(arr, count, key)] == key)
+                                           : (lower == ~smd_binary_search(arr, count, key)));
+        }
+    }
+
+    UT_END();
+}
+
+static void bsearch_test4()
+{
+    int arr[200];
+    int keys[100];
+    ptrdiff_t results[100];
+    int count;
+    int key_count;
+    int i;
+
+    UT_BEGIN("bsearch test #4: batch search");
+
+    for (count = 0; count <= 200; count += 13)
+    {
+        for (i = 0; i < count; ++i)
+        {
+            arr[i] = 2 * (i / 3 + i / 5);
+        }
+
+        // the last batch is incomplete unless the count of keys is a multiple of the batch size
+        for (key_count = 0; key_count <= 100; key_count += 11)
+        {
+            for (i = 0; i < key_count; ++i)
+            {
+                keys[i] = (i * 37) % (count + 3) - 1;
+            }
+
+            int_binary_search_batch(arr, (size_t)count, keys, (size_t)key_count, results);
+
+            for (i = 0; i < key_count; ++i)
+            {
+                UT_VERIFY_SILENT(results[i] == int_branchless_binary_search(arr, (size_t)count, keys[i]));
+            }
+        }
+    }
+
+    UT_END();
+}
+
 void test_bsearch()
 {
     bsearch_test1();
+    bsearch_test2();
+    bsearch_test3();
+    bsearch_test4();
 }
@@ -0,0 +1,97 @@
+#include <utilities/ut/ut.h>
+#include <utilities/alloc.h>
+
+
+#define EYTZINGER_NS(name)      eyt_##name
+#define EYTZINGER_ELEMENT_TYPE  int
+#define EYTZINGER_KEY_TYPE      int
+#define EYTZINGER_3W_COMPARE(array, index, key) (key - array[index])
+#define EYTZINGER_PREFETCH(array, index) __builtin_prefetch(&array[index])
+#include <templates/eytzinger.h>
+
+static void eytzinger_test1()
+{
+    int sorted[] = { 10, 20, 30, 40, 50, 60 };
+    int layout[sizeof(sorted) / sizeof(sorted[0]) + 1];
+    size_t count = sizeof(sorted) / sizeof(sorted[0]);
+
+    UT_BEGIN("eytzinger test #1");
+
+    eyt_eytzinger_arrange(sorted, count, layout);
+
+    // the root is the median, its children are the medians of the halves
+    UT_VERIFY(layout[1] == 40 && layout[2] == 20 && layout[3] == 60);
+    UT_VERIFY(layout[4] == 10 && layout[5] == 30 && layout[6] == 50);
+
+    // positive tests
+    UT_VERIFY(10 == layout[eyt_eytzinger_search(layout, count, 10)]);
+    UT_VERIFY(30 == layout[eyt_eytzinger_search(layout, count, 30)]);
+    UT_VERIFY(60 == layout[eyt_eytzinger_search(layout, count, 60)]);
+
+    // negative tests
+    UT_VERIFY(0 == eyt_eytzinger_search(layout, count, 5));
+    UT_VERIFY(0 == eyt_eytzinger_search(layout, count, 35));
+    UT_VERIFY(0 == eyt_eytzinger_search(layout, count, 65));
+
+    // lower bound
+    UT_VERIFY(10 == layout[eyt_eytzinger_lower_bound(layout, count, 5)]);
+    UT_VERIFY(40 == layout[eyt_eytzinger_lower_bound(layout, count, 35)]);
+    UT_VERIFY(60 == layout[eyt_eytzinger_lower_bound(layout, count, 55)]);
+    UT_VERIFY(0 == eyt_eytzinger_lower_bound(layout, count, 65));
+
+    // empty array
+    UT_VERIFY(0 == eyt_eytzinger_lower_bound(layout, 0, 10));
+    UT_VERIFY(0 == eyt_eytzinger_search(layout, 0, 10));
+
+    UT_END();
+}
+
+static void eytzinger_test2()
+{
+    int sorted[130];
+    int layout[sizeof(sorted) / sizeof(sorted[0]) + 1];
+    size_t count;
+    size_t i;
+    int key;
+
+    UT_BEGIN("eytzinger test #2 - all sizes");
+
+    for (i = 0; i < sizeof(sorted) / sizeof(sorted[0]); ++i)
+    {
+        sorted[i] = (int)(2 * i + 2);
+    }
+
+    // compare to the lower bound over the sorted array for each of the complete and incomplete trees
+    for (count = 1; count <= sizeof(sorted) / sizeof(sorted[0]); ++count)
+    {
+        eyt_eytzinger_arrange(sorted, count, layout);
+
+        for (key = 0; key <= (int)(2 * count + 3); ++key)
+        {
+            size_t expected = (key <= 2) ? 0 : (size_t)(key - 1) / 2;
+            size_t position = eyt_eytzinger_lower_bound(layout, count, key);
+
+            if (expected < count)
+            {
+                UT_VERIFY_SILENT(position != 0 && layout[position] == sorted[expected]);
+                UT_VERIFY_SILENT((0 != eyt_eytzinger_search(layout, count, key)) == (key == sorted[expected]));
+            }
+            else
+            {
+                UT_VERIFY_SILENT(position == 0);
+                UT_VERIFY_SILENT(0 == eyt_eytzinger_search(layout, count, key));
+            }
+        }
+    }
+
+    UT_END();
+}
+
+/*
+ * function that launches tests
+ */
+void test_eytzinger()
+{
+    eytzinger_test1();
+    eytzinger_test2();
+}
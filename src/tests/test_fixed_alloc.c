@@ -388,6 +388,825 @@ static void fxtst3()
     UT_END();
 }
 
+/*
+ * test fixed allocator with aligned clusters
+ */
+
+#define FIXED_ALLOC_NS(n)            aln_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     struct MyStruct
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (3)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+
+#include <templates/fixed_alloc.h>
+
+static void fxtst4()
+{
+    aln_allocator allocator;
+    struct MyStruct ** pp;
+    size_t used;
+    size_t allocated;
+    size_t i;
+    const size_t len = 1000;
+
+    UT_BEGIN("fixed alloc w/aligned clusters");
+    aln_init_allocator(&allocator);
+
+    UT_VERIFY(allocator.cluster_alignment >= aln_internal_get_cluster_size(3));
+    UT_VERIFY(0 == (allocator.cluster_alignment & (allocator.cluster_alignment - 1)));
+
+    pp = xmalloc(sizeof(struct MyStruct *) * len);
+
+    for (i = 0; i < len; ++i)
+    {
+        pp[i] = aln_alloc_elem(&allocator);
+        MYS_INIT(pp[i], (int)i, (unsigned short)i, (double)i);
+        UT_VERIFY_SILENT(aln_internal_find_cluster(&allocator, pp[i]) != NULL);
+    }
+
+    aln_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated >= len));
+
+    /* release every odd element first and then the rest ones */
+    for (i = 1; i < len; i += 2)
+    {
+        aln_free_elem(&allocator, pp[i]);
+    }
+
+    aln_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY(used == len / 2);
+
+    for (i = 0; i < len; i += 2)
+    {
+        UT_VERIFY_SILENT(MYS_EQUALS2(pp[i], (int)i, (unsigned short)i, (double)i));
+        aln_free_elem(&allocator, pp[i]);
+    }
+
+    aln_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY(used == 0);
+
+    /* released elements shall be reused */
+    for (i = 0; i < len; ++i)
+    {
+        pp[i] = aln_alloc_elem(&allocator);
+    }
+
+    {
+        size_t allocated2;
+        aln_get_allocator_status(&allocator, &used, &allocated2);
+        UT_VERIFY((used == len) && (allocated2 == allocated));
+    }
+
+    xfree(pp);
+    aln_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * test that elements freed in the old clusters are reused before the new cluster is allocated
+ */
+static void fxtst5()
+{
+    aln_allocator allocator;
+    struct MyStruct ** pp;
+    size_t used;
+    size_t allocated;
+    size_t i;
+    size_t len;
+
+    UT_BEGIN("fixed alloc reuses elements of the old clusters");
+    aln_init_allocator(&allocator);
+
+    /* fill three clusters completely */
+    aln_free_elem(&allocator, aln_alloc_elem(&allocator));
+    aln_get_allocator_status(&allocator, &used, &allocated);
+    len = allocated * 3;
+
+    pp = xmalloc(sizeof(struct MyStruct *) * len);
+    for (i = 0; i < len; ++i)
+    {
+        pp[i] = aln_alloc_elem(&allocator);
+    }
+
+    aln_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == len));
+
+    /* free scattered elements in all the clusters */
+    for (i = 1; i < len; i += 7)
+    {
+        aln_free_elem(&allocator, pp[i]);
+    }
+
+    for (i = 1; i < len; i += 7)
+    {
+        size_t j;
+        struct MyStruct * e = aln_alloc_elem(&allocator);
+        bool found = false;
+
+        for (j = 1; j < len; j += 7)
+        {
+            found = found || (pp[j] == e);
+        }
+
+        UT_VERIFY_SILENT(found);
+    }
+
+    aln_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == len));
+
+    xfree(pp);
+    aln_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * test fixed allocator with free masks separated from the elements payload
+ */
+
+#define FIXED_ALLOC_NS(n)            sep_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     double
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (5)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_FOREACH_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_SEPARATE_MASKS
+#define FIXED_ALLOC_PAYLOAD_ALIGNMENT (4096)
+
+#include <templates/fixed_alloc.h>
+
+#define NS(name) sep_##name
+#define ELEMENT_TYPE double
+#include "test_alloc_foreach.h"
+
+static void fxtst6()
+{
+    sep_allocator allocator;
+    double ** pp;
+    double * arr;
+    size_t used;
+    size_t allocated;
+    size_t i;
+    size_t j;
+    const size_t len = 1500;
+
+    UT_BEGIN("fixed alloc w/separate masks");
+    sep_init_allocator(&allocator);
+
+    pp = xmalloc(sizeof(double *) * len);
+    arr = xmalloc(sizeof(double) * len);
+
+    for (i = 0; i < len; ++i)
+    {
+        pp[i] = sep_alloc_elem(&allocator);
+        *pp[i] = get_next_num(i);
+
+        /* payload is expected to be aligned to the page size */
+        UT_VERIFY_SILENT(0 == (((size_t)sep_internal_get_elem(sep_internal_find_cluster(&allocator, pp[i]), 0, 0)) % 4096));
+    }
+
+    sep_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated % (5 * sizeof(unsigned long) * CHAR_BIT) == 0));
+
+    for (i = 0; i < len; i += 3)
+    {
+        sep_free_elem(&allocator, pp[i]);
+    }
+
+    for (i = 0, j = 0; i < len; ++i)
+    {
+        if (0 != (i % 3))
+        {
+            UT_VERIFY_SILENT(*pp[i] == get_next_num(i));
+            arr[j++] = get_next_num(i);
+        }
+    }
+
+    sep_test_foreach("foreach test for allocator w/separate masks", &allocator, arr, j);
+
+    for (i = 0; i < len; i += 3)
+    {
+        pp[i] = sep_alloc_elem(&allocator);
+    }
+
+    {
+        size_t allocated2;
+        sep_get_allocator_status(&allocator, &used, &allocated2);
+        UT_VERIFY((used == len) && (allocated2 == allocated));
+    }
+
+    xfree(arr);
+    xfree(pp);
+    sep_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * test fixed allocator that releases empty clusters
+ */
+
+#define FIXED_ALLOC_NS(n)            rel_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (2)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_RETAINED_EMPTY_CLUSTERS (2)
+
+#include <templates/fixed_alloc.h>
+
+static void fxtst7()
+{
+    rel_allocator allocator;
+    int ** pp;
+    int * e;
+    size_t used;
+    size_t allocated;
+    size_t cluster_capacity;
+    size_t i;
+    size_t len;
+
+    UT_BEGIN("fixed alloc w/release of empty clusters");
+    rel_init_allocator(&allocator);
+
+    e = rel_alloc_elem(&allocator);
+    rel_get_allocator_status(&allocator, &used, &cluster_capacity);
+    UT_VERIFY((used == 1) && (allocator.empty_clusters == 0));
+
+    /* alloc/free sequence on the cluster's boundary keeps the cluster */
+    for (i = 0; i < 10; ++i)
+    {
+        rel_free_elem(&allocator, e);
+        rel_get_allocator_status(&allocator, &used, &allocated);
+        UT_VERIFY_SILENT((used == 0) && (allocated == cluster_capacity) && (allocator.empty_clusters == 1));
+
+        e = rel_alloc_elem(&allocator);
+        UT_VERIFY_SILENT(allocator.empty_clusters == 0);
+    }
+
+    /* fill five clusters */
+    len = cluster_capacity * 5;
+    pp = xmalloc(sizeof(int *) * len);
+    pp[0] = e;
+    for (i = 1; i < len; ++i)
+    {
+        pp[i] = rel_alloc_elem(&allocator);
+        *pp[i] = (int)i;
+    }
+
+    rel_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == len));
+
+    /* free all the elements of the three clusters in the middle */
+    for (i = cluster_capacity; i < cluster_capacity * 4; ++i)
+    {
+        rel_free_elem(&allocator, pp[i]);
+    }
+
+    /* two of them are retained */
+    rel_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == cluster_capacity * 2) && (allocated == cluster_capacity * 4));
+    UT_VERIFY(allocator.empty_clusters == 2);
+
+    for (i = cluster_capacity * 4; i < len; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+        rel_free_elem(&allocator, pp[i]);
+    }
+
+    rel_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == cluster_capacity) && (allocated == cluster_capacity * 3));
+
+    /* retained clusters are reused */
+    for (i = cluster_capacity; i < len; ++i)
+    {
+        pp[i] = rel_alloc_elem(&allocator);
+    }
+
+    rel_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == len) && (allocator.empty_clusters == 0));
+
+    for (i = 0; i < len; ++i)
+    {
+        rel_free_elem(&allocator, pp[i]);
+    }
+
+    rel_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == cluster_capacity * 2));
+
+    xfree(pp);
+    rel_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * test fixed allocators with geometric chunks growth
+ */
+
+#define FIXED_ALLOC_NS(n)            grw_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (4)
+#define FIXED_ALLOC_MAX_CHUNK_SIZE   (16)
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_BATCH_REQUIRED
+
+#include <templates/fixed_alloc.h>
+
+#define FIXED_ALLOC_NS(n)            gfr_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (1)
+#define FIXED_ALLOC_MAX_CHUNK_SIZE   (4)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_FOREACH_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+
+#include <templates/fixed_alloc.h>
+
+#define NS(name) gfr_##name
+#define ELEMENT_TYPE int
+#include "test_alloc_foreach.h"
+
+static void fxtst8()
+{
+    grw_allocator allocator;
+    int * pp[29];
+    size_t used;
+    size_t allocated;
+    size_t i;
+
+    UT_BEGIN("fixed alloc w/geometric growth");
+    grw_init_allocator(&allocator);
+
+    for (i = 0; i < 4; ++i)
+    {
+        pp[i] = grw_alloc_elem(&allocator);
+        *pp[i] = (int)i;
+    }
+
+    grw_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 4) && (allocated == 4));
+
+    pp[4] = grw_alloc_elem(&allocator);
+    *pp[4] = 4;
+    grw_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 5) && (allocated == 4 + 8));
+
+    /* chunks are 4, 8, 16, 16 elements long */
+    for (i = 5; i < 29; ++i)
+    {
+        pp[i] = grw_alloc_elem(&allocator);
+        *pp[i] = (int)i;
+    }
+
+    grw_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 29) && (allocated == 4 + 8 + 16 + 16));
+
+    for (i = 0; i < 29; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+    }
+
+    grw_uninit_allocator(&allocator);
+    UT_END();
+}
+
+static void fxtst9()
+{
+    gfr_allocator allocator;
+    int ** pp;
+    int * arr;
+    size_t used;
+    size_t allocated;
+    size_t i;
+    size_t len;
+    const size_t bits = sizeof(unsigned long) * CHAR_BIT;
+
+    UT_BEGIN("fixed alloc w/geometric growth of clusters");
+    gfr_init_allocator(&allocator);
+
+    /* clusters hold 1, 2, 4, 4 chunks */
+    len = 7 * bits + 1;
+    pp = xmalloc(sizeof(int *) * len);
+    arr = xmalloc(sizeof(int) * len);
+    for (i = 0; i < len; ++i)
+    {
+        pp[i] = gfr_alloc_elem(&allocator);
+        *pp[i] = (int)i;
+    }
+
+    gfr_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == 11 * bits));
+
+    /* empty the two oldest clusters, the first one is retained */
+    for (i = 0; i < 3 * bits; ++i)
+    {
+        UT_VERIFY_SILENT(gfr_internal_find_cluster(&allocator, pp[i])->chunk_count == (i < bits ? 1 : 2));
+        gfr_free_elem(&allocator, pp[i]);
+    }
+
+    gfr_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len - 3 * bits) && (allocated == 9 * bits));
+
+    for (i = 3 * bits; i < len; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+        arr[i - 3 * bits] = (int)i;
+    }
+
+    gfr_test_foreach("foreach test for allocator w/geometric growth", &allocator, arr, len - 3 * bits);
+
+    for (i = 3 * bits; i < len; ++i)
+    {
+        gfr_free_elem(&allocator, pp[i]);
+    }
+
+    gfr_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == bits));
+
+    xfree(arr);
+    xfree(pp);
+    gfr_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * test batch functions
+ */
+
+#define FIXED_ALLOC_NS(n)            bat_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (3)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_FOREACH_REQUIRED
+#define FIXED_ALLOC_ALIGNED_CLUSTERS
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_BATCH_REQUIRED
+
+#include <templates/fixed_alloc.h>
+
+#define NS(name) bat_##name
+#define ELEMENT_TYPE int
+#include "test_alloc_foreach.h"
+
+static void fxtst10()
+{
+    grw_allocator grw_allocator;
+    bat_allocator allocator;
+    int ** pp;
+    int ** odd;
+    int * arr;
+    size_t used;
+    size_t allocated;
+    size_t cluster_capacity;
+    size_t i;
+    const size_t len = 1000;
+
+    UT_BEGIN("fixed alloc batch functions");
+
+    pp = xmalloc(sizeof(int *) * len);
+    odd = xmalloc(sizeof(int *) * len);
+    arr = xmalloc(sizeof(int) * len);
+
+    /* allocator w/o free function */
+    grw_init_allocator(&grw_allocator);
+    pp[0] = grw_alloc_elem(&grw_allocator);
+    grw_alloc_elem_n(&grw_allocator, pp + 1, 40);
+    for (i = 0; i < 41; ++i)
+    {
+        *pp[i] = (int)i;
+    }
+
+    for (i = 0; i < 41; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+    }
+
+    grw_get_allocator_status(&grw_allocator, &used, &allocated);
+    UT_VERIFY((used == 41) && (allocated == 4 + 8 + 16 + 16));
+    grw_uninit_allocator(&grw_allocator);
+
+    /* allocator w/free function */
+    bat_init_allocator(&allocator);
+    pp[0] = bat_alloc_elem(&allocator);
+    bat_get_allocator_status(&allocator, &used, &cluster_capacity);
+
+    bat_alloc_elem_n(&allocator, pp + 1, 4);
+    bat_alloc_elem_n(&allocator, pp + 5, len - 5);
+    for (i = 0; i < len; ++i)
+    {
+        *pp[i] = (int)i;
+    }
+
+    for (i = 0; i < len; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+    }
+
+    bat_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == (len + cluster_capacity - 1) / cluster_capacity * cluster_capacity));
+
+    /* free odd elements */
+    for (i = 0; i < len / 2; ++i)
+    {
+        odd[i] = pp[2 * i + 1];
+        arr[i] = (int)(2 * i);
+    }
+
+    bat_free_elem_n(&allocator, odd, len / 2);
+    bat_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY(used == len / 2);
+
+    bat_test_foreach("foreach test for batch functions", &allocator, arr, len / 2);
+
+    /* freed elements are reused */
+    bat_alloc_elem_n(&allocator, odd, len / 2);
+    {
+        size_t allocated2;
+        bat_get_allocator_status(&allocator, &used, &allocated2);
+        UT_VERIFY((used == len) && (allocated2 == allocated));
+    }
+
+    for (i = 0; i < len / 2; ++i)
+    {
+        pp[2 * i + 1] = odd[i];
+    }
+
+    bat_free_elem_n(&allocator, pp, len);
+    bat_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == cluster_capacity));
+
+    bat_uninit_allocator(&allocator);
+    xfree(arr);
+    xfree(odd);
+    xfree(pp);
+    UT_END();
+}
+
+/*
+ * test allocators clear
+ */
+
+#define FIXED_ALLOC_NS(n)            cln_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (4)
+#define FIXED_ALLOC_MAX_CHUNK_SIZE   (16)
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_CLEAR_REQUIRED
+#define FIXED_ALLOC_CLEAR_RETAINED_SIZE (20)
+
+#include <templates/fixed_alloc.h>
+
+#define FIXED_ALLOC_NS(n)            clr_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (2)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_FOREACH_REQUIRED
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_CLEAR_REQUIRED
+#define FIXED_ALLOC_CLEAR_RETAINED_SIZE (2 * 2 * sizeof(unsigned long) * CHAR_BIT)
+
+#include <templates/fixed_alloc.h>
+
+#define NS(name) clr_##name
+#define ELEMENT_TYPE int
+#include "test_alloc_foreach.h"
+
+static void fxtst11()
+{
+    cln_allocator cln_allocator;
+    clr_allocator allocator;
+    int ** pp;
+    int * arr;
+    size_t used;
+    size_t allocated;
+    size_t cluster_capacity;
+    size_t i;
+    const size_t len = 1000;
+
+    UT_BEGIN("fixed alloc clear");
+
+    pp = xmalloc(sizeof(int *) * len);
+    arr = xmalloc(sizeof(int) * len);
+
+    /* allocator w/o free function: chunks are 4, 8, 16, 16, 16 elements long */
+    cln_init_allocator(&cln_allocator);
+    for (i = 0; i < 50; ++i)
+    {
+        *cln_alloc_elem(&cln_allocator) = (int)i;
+    }
+
+    cln_get_allocator_status(&cln_allocator, &used, &allocated);
+    UT_VERIFY((used == 50) && (allocated == 60));
+
+    /* the two most recent chunks are kept */
+    cln_allocator_clear(&cln_allocator);
+    cln_get_allocator_status(&cln_allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == 0) && (cln_allocator.chunk == NULL));
+
+    for (i = 0; i < 32; ++i)
+    {
+        pp[i] = cln_alloc_elem(&cln_allocator);
+        *pp[i] = (int)i;
+    }
+
+    UT_VERIFY(cln_allocator.spare_chunk == NULL);
+
+    for (i = 0; i < 32; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+    }
+
+    cln_get_allocator_status(&cln_allocator, &used, &allocated);
+    UT_VERIFY((used == 32) && (allocated == 32));
+
+    cln_allocator_clear(&cln_allocator);
+    cln_uninit_allocator(&cln_allocator);
+
+    /* allocator w/free function */
+    clr_init_allocator(&allocator);
+    pp[0] = clr_alloc_elem(&allocator);
+    clr_get_allocator_status(&allocator, &used, &cluster_capacity);
+
+    for (i = 1; i < len; ++i)
+    {
+        pp[i] = clr_alloc_elem(&allocator);
+    }
+
+    for (i = 0; i < len; i += 2)
+    {
+        clr_free_elem(&allocator, pp[i]);
+    }
+
+    /* two clusters are kept */
+    clr_allocator_clear(&allocator);
+    clr_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == 2 * cluster_capacity) && (allocator.empty_clusters == 2));
+
+    /* kept clusters are reused */
+    for (i = 0; i < 2 * cluster_capacity; ++i)
+    {
+        pp[i] = clr_alloc_elem(&allocator);
+        *pp[i] = (int)i;
+        arr[i] = (int)i;
+    }
+
+    clr_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 2 * cluster_capacity) && (allocated == used) && (allocator.empty_clusters == 0));
+
+    clr_test_foreach("foreach test for cleared allocator", &allocator, arr, 2 * cluster_capacity);
+
+    for (i = 0; i < 2 * cluster_capacity; ++i)
+    {
+        clr_free_elem(&allocator, pp[i]);
+    }
+
+    clr_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == cluster_capacity));
+
+    clr_uninit_allocator(&allocator);
+    xfree(arr);
+    xfree(pp);
+    UT_END();
+}
+
+/*
+ * test fixed allocator w/clusters carved from mmap regions
+ */
+
+#define FIXED_ALLOC_NS(n)            mmp_##n
+#define FIXED_ALLOC_ELEMENT_TYPE     int
+#define FIXED_ALLOC_XMALLOC          xmalloc
+#define FIXED_ALLOC_XFREE            xfree
+#define FIXED_ALLOC_INITIAL_CHUNK_SIZE (4)
+#define FIXED_ALLOC_FREE_FUNCTION_REQUIRED
+#define FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+#define FIXED_ALLOC_FOREACH_REQUIRED
+#define FIXED_ALLOC_RELEASE_EMPTY_CLUSTERS
+#define FIXED_ALLOC_MMAP_REGIONS
+#define FIXED_ALLOC_MMAP_REGION_SIZE (64 * 1024)
+
+#include <templates/fixed_alloc.h>
+
+#define NS(name) mmp_##name
+#define ELEMENT_TYPE int
+#include "test_alloc_foreach.h"
+
+static void fxtst12()
+{
+    mmp_allocator allocator;
+    int ** pp;
+    int * arr;
+    size_t used;
+    size_t allocated;
+    size_t cluster_capacity;
+    size_t slot_count;
+    size_t len;
+    size_t i;
+    size_t j;
+
+    UT_BEGIN("fixed alloc w/mmap regions");
+    mmp_init_allocator(&allocator);
+
+    mmp_free_elem(&allocator, mmp_alloc_elem(&allocator));
+    mmp_get_allocator_status(&allocator, &used, &cluster_capacity);
+
+    /* fill three regions */
+    slot_count = allocator.region_size / allocator.cluster_alignment;
+    UT_VERIFY(slot_count > 1);
+
+    len = 3 * slot_count * cluster_capacity;
+    pp = xmalloc(sizeof(int *) * len);
+    arr = xmalloc(sizeof(int) * len);
+
+    for (i = 0; i < len; ++i)
+    {
+        pp[i] = mmp_alloc_elem(&allocator);
+        *pp[i] = (int)i;
+    }
+
+    /* all the regions are full */
+    mmp_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == len) && (allocator.free_region == NULL));
+
+    for (i = 0; i < len; ++i)
+    {
+        UT_VERIFY_SILENT((mmp_internal_find_cluster(&allocator, pp[i])->region != NULL) && (*pp[i] == (int)i));
+    }
+
+    /* empty all the clusters of the first two regions but one */
+    for (i = 0; i < 2 * slot_count * cluster_capacity; ++i)
+    {
+        if (i != cluster_capacity / 2)
+        {
+            mmp_free_elem(&allocator, pp[i]);
+        }
+    }
+
+    mmp_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == slot_count * cluster_capacity + 1) && (allocated == (slot_count + 2) * cluster_capacity));
+
+    /* the first region keeps non-empty cluster and the retained empty one, the second region is unmapped */
+    UT_VERIFY((allocator.free_region != NULL) && (allocator.free_region->next == NULL) &&
+        (allocator.free_region->used == 2));
+
+    for (i = 2 * slot_count * cluster_capacity, j = 0; i < len; ++i, ++j)
+    {
+        UT_VERIFY_SILENT(*pp[i] == (int)i);
+        arr[j] = (int)i;
+    }
+    arr[j++] = (int)(cluster_capacity / 2);
+
+    mmp_test_foreach("foreach test for allocator w/mmap regions", &allocator, arr, j);
+
+    /* released slots are reused */
+    for (i = 0; i < 2 * slot_count * cluster_capacity; ++i)
+    {
+        if (i != cluster_capacity / 2)
+        {
+            pp[i] = mmp_alloc_elem(&allocator);
+        }
+    }
+
+    mmp_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == len) && (allocated == len));
+
+    for (i = 0; i < len; ++i)
+    {
+        mmp_free_elem(&allocator, pp[i]);
+    }
+
+    mmp_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated == cluster_capacity));
+
+    xfree(arr);
+    xfree(pp);
+    mmp_uninit_allocator(&allocator);
+    UT_VERIFY(allocator.free_region == NULL);
+    UT_END();
+}
+
 /*
  * function that launches tests
  */
@@ -396,5 +1215,14 @@ void test_fixed_alloc()
     fxtst1();
     fxtst2();
     fxtst3();
+    fxtst4();
+    fxtst5();
+    fxtst6();
+    fxtst7();
+    fxtst8();
+    fxtst9();
+    fxtst10();
+    fxtst11();
+    fxtst12();
 }
 
@@ -0,0 +1,204 @@
+#include <utilities/ut/ut.h>
+#include <utilities/alloc.h>
+
+#include <stdint.h>
+
+
+#define INTERPOLATION_SEARCH_NS(name)       i64_##name
+#define INTERPOLATION_SEARCH_ARRAY_TYPE     const int64_t *
+#define INTERPOLATION_SEARCH_KEY_TYPE       int64_t
+#define INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) (array[index])
+#include <templates/interpolation_search.h>
+
+/*
+ * counts the elements read by the search
+ */
+static size_t g_reads_count;
+
+#define INTERPOLATION_SEARCH_NS(name)       cnt_##name
+#define INTERPOLATION_SEARCH_ARRAY_TYPE     const int64_t *
+#define INTERPOLATION_SEARCH_KEY_TYPE       int64_t
+#define INTERPOLATION_SEARCH_ELEMENT_KEY(array, index) (++g_reads_count, array[index])
+#include <templates/interpolation_search.h>
+
+/*
+ * plain lower bound the search results are checked against
+ */
+static size_t linear_lower_bound(const int64_t * arr, size_t count, int64_t key)
+{
+    size_t lower = 0;
+
+    while ((lower < count) && (arr[lower] < key))
+    {
+        ++lower;
+    }
+
+    return lower;
+}
+
+static void interpolation_search_test1()
+{
+    int64_t arr[] = { 10, 20, 30, 30, 30, 40, 50 };
+    size_t count = sizeof(arr) / sizeof(arr[0]);
+
+    UT_BEGIN("interpolation search test #1");
+
+    // positive tests
+    UT_VERIFY(0 == i64_interpolation_search(arr, count, 10));
+    UT_VERIFY(1 == i64_interpolation_search(arr, count, 20));
+    UT_VERIFY(2 == i64_interpolation_search(arr, count, 30));
+    UT_VERIFY(5 == i64_interpolation_search(arr, count, 40));
+    UT_VERIFY(6 == i64_interpolation_search(arr, count, 50));
+
+    // negative tests
+    UT_VERIFY(0 == ~i64_interpolation_search(arr, count, 5));
+    UT_VERIFY(2 == ~i64_interpolation_search(arr, count, 25));
+    UT_VERIFY(5 == ~i64_interpolation_search(arr, count, 35));
+    UT_VERIFY(7 == ~i64_interpolation_search(arr, count, 55));
+    UT_VERIFY(0 == ~i64_interpolation_search(arr, 0, 10));
+
+    // the keys that are far outside of the elements' range
+    UT_VERIFY(0 == i64_interpolation_lower_bound(arr, count, INT64_MIN));
+    UT_VERIFY(count == i64_interpolation_lower_bound(arr, count, INT64_MAX));
+
+    UT_END();
+}
+
+static void interpolation_search_test2()
+{
+    int64_t arr[300];
+    size_t count;
+    size_t i;
+    int64_t key;
+
+    UT_BEGIN("interpolation search test #2: skewed arrays of various sizes");
+
+    for (count = 0; count <= 300; count += 23)
+    {
+        // the quadratic growth with the runs of equal elements
+        for (i = 0; i < count; ++i)
+        {
+            arr[i] = (int64_t)((i / 3) * (i / 3));
+        }
+
+        for (key = -1; key <= (count > 0 ? arr[count - 1] + 1 : 0); ++key)
+        {
+            size_t lower = 0;
+
+            while ((lower < count) && (arr[lower] < key))
+            {
+                ++lower;
+            }
+
+            UT_VERIFY_SILENT(lower == i64_interpolation_lower_bound(arr, count, key));
+        }
+    }
+
+    UT_END();
+}
+
+static void interpolation_search_test3()
+{
+    const size_t count = 1 << 16;
+    int64_t * arr = xmalloc(count * sizeof(int64_t));
+    size_t max_reads = 0;
+    size_t i;
+
+    UT_BEGIN("interpolation search test #3: adversarial array");
+
+    // the last element makes the interpolation estimate every position close to the beginning of the range
+    for (i = 0; i < count - 1; ++i)
+    {
+        arr[i] = (int64_t)i;
+    }
+    arr[count - 1] = INT64_MAX / 2;
+
+    for (i = 0; i < count - 1; i += 7)
+    {
+        g_reads_count = 0;
+        UT_VERIFY_SILENT((ptrdiff_t)i == cnt_interpolation_search(arr, count, (int64_t)i));
+        max_reads = g_reads_count > max_reads ? g_reads_count : max_reads;
+    }
+
+    // each step reads the range bounds and two probes at most and halves the range
+    UT_VERIFY(max_reads <= 4 * (16 + 1) + 1);
+
+    xfree(arr);
+    UT_END();
+}
+
+static void interpolation_search_test4()
+{
+    // nanosecond timestamp, the neighbour keys are equal once converted to double
+    const int64_t base = INT64_C(1700000000000000000);
+    int64_t arr[1000];
+    size_t count = sizeof(arr) / sizeof(arr[0]);
+    size_t i;
+    int64_t key;
+
+    UT_BEGIN("interpolation search test #4: consecutive wide keys");
+
+    for (i = 0; i < count; ++i)
+    {
+        arr[i] = base + (int64_t)i;
+    }
+
+    for (key = base - 2; key <= base + (int64_t)count + 1; ++key)
+    {
+        UT_VERIFY_SILENT(linear_lower_bound(arr, count, key) == i64_interpolation_lower_bound(arr, count, key));
+    }
+
+    // the same keys in the short ranges
+    for (i = 1; i <= 4; ++i)
+    {
+        for (key = base - 1; key <= base + (int64_t)i; ++key)
+        {
+            UT_VERIFY_SILENT(linear_lower_bound(arr, i, key) == i64_interpolation_lower_bound(arr, i, key));
+        }
+    }
+
+    UT_END();
+}
+
+static void interpolation_search_test5()
+{
+    int64_t arr[64];
+    int64_t keys[] = { INT64_MIN, INT64_MIN + 1, INT64_MIN + 31, INT64_MIN + 32, -1, 0, 1,
+                       INT64_MAX - 32, INT64_MAX - 31, INT64_MAX - 1, INT64_MAX };
+    size_t count = sizeof(arr) / sizeof(arr[0]);
+    size_t i;
+    size_t j;
+
+    UT_BEGIN("interpolation search test #5: keys at the limits of int64");
+
+    // the first half of the elements is close to INT64_MIN, the second one - to INT64_MAX
+    for (i = 0; i < count / 2; ++i)
+    {
+        arr[i] = INT64_MIN + (int64_t)i;
+        arr[count - 1 - i] = INT64_MAX - (int64_t)i;
+    }
+
+    for (i = 0; i <= count; ++i)
+    {
+        for (j = 0; j < sizeof(keys) / sizeof(keys[0]); ++j)
+        {
+            UT_VERIFY_SILENT(linear_lower_bound(arr, i, keys[j]) == i64_interpolation_lower_bound(arr, i, keys[j]));
+            UT_VERIFY_SILENT(linear_lower_bound(arr + count - i, i, keys[j]) ==
+                             i64_interpolation_lower_bound(arr + count - i, i, keys[j]));
+        }
+    }
+
+    UT_END();
+}
+
+/*
+ * function that launches tests
+ */
+void test_interpolation_search()
+{
+    interpolation_search_test1();
+    interpolation_search_test2();
+    interpolation_search_test3();
+    interpolation_search_test4();
+    interpolation_search_test5();
+}
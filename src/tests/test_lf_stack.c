@@ -0,0 +1,163 @@
+#include <utilities/ut/ut.h>
+#include <utilities/alloc.h>
+
+#include <pthread.h>
+#include <string.h>
+
+/*
+ * test lock-free stack
+ */
+
+#define LF_STACK_NS(n)                  lfi_##n
+#define LF_STACK_ELEMENT_TYPE           size_t
+#define LF_STACK_XMALLOC                xmalloc
+#define LF_STACK_XFREE                  xfree
+#define LF_STACK_INITIAL_CHUNK_SIZE     (2)
+
+#include <templates/lf_stack.h>
+
+static void lfstktst1()
+{
+    lfi_lf_stack stack;
+    size_t n;
+    size_t i;
+
+    UT_BEGIN("lock-free stack w/single thread");
+    lfi_lf_stack_init(&stack);
+
+    UT_VERIFY(lfi_lf_stack_empty(&stack) && !lfi_lf_stack_pop(&stack, &n));
+
+    for (i = 0; i < 1000; ++i)
+    {
+        UT_VERIFY_SILENT(lfi_lf_stack_push(&stack, i));
+    }
+
+    /* chunks of 2, 4, 8, ... 512 nodes */
+    UT_VERIFY(!lfi_lf_stack_empty(&stack) && (stack.chunk_count == 9));
+
+    for (i = 1000; i > 0; --i)
+    {
+        UT_VERIFY_SILENT(lfi_lf_stack_pop(&stack, &n) && (n == i - 1));
+    }
+
+    UT_VERIFY(lfi_lf_stack_empty(&stack) && !lfi_lf_stack_pop(&stack, &n));
+
+    /* the freed nodes are reused */
+    for (i = 0; i < 1000; ++i)
+    {
+        lfi_lf_stack_push(&stack, i);
+    }
+
+    UT_VERIFY(stack.chunk_count == 9);
+
+    lfi_lf_stack_uninit(&stack);
+
+    /* push fails once all the chunks are in use and there are no free nodes */
+    lfi_lf_stack_init(&stack);
+    stack.chunk_count = LF_STACK_INTERNAL_MAX_CHUNKS;
+    UT_VERIFY(!lfi_lf_stack_push(&stack, 0) && lfi_lf_stack_empty(&stack) &&
+              (stack.chunk_count == LF_STACK_INTERNAL_MAX_CHUNKS));
+    stack.chunk_count = 0;
+    lfi_lf_stack_uninit(&stack);
+
+    UT_END();
+}
+
+/*
+ * each thread pushes its own values and pops any values concurrently with the other threads
+ */
+
+#define LF_THREADS_COUNT    (4)
+#define LF_ELEMENTS_COUNT   (20000)
+
+struct LfTestContext
+{
+    lfi_lf_stack    stack;
+    unsigned char   popped[LF_THREADS_COUNT * LF_ELEMENTS_COUNT];
+    size_t          index;
+    size_t          errors;
+    pthread_mutex_t lock;
+};
+
+static void * lf_thread_proc(void * p)
+{
+    struct LfTestContext * context = p;
+    size_t errors = 0;
+    size_t index;
+    size_t n;
+    size_t i;
+
+    pthread_mutex_lock(&context->lock);
+    index = context->index++;
+    pthread_mutex_unlock(&context->lock);
+
+    for (i = 0; i < LF_ELEMENTS_COUNT; ++i)
+    {
+        lfi_lf_stack_push(&context->stack, index * LF_ELEMENTS_COUNT + i);
+
+        if ((i % 3) && lfi_lf_stack_pop(&context->stack, &n))
+        {
+            /* each value is popped by exactly one thread */
+            errors += (0 != context->popped[n]++);
+        }
+    }
+
+    while (lfi_lf_stack_pop(&context->stack, &n))
+    {
+        errors += (0 != context->popped[n]++);
+    }
+
+    pthread_mutex_lock(&context->lock);
+    context->errors += errors;
+    pthread_mutex_unlock(&context->lock);
+    return NULL;
+}
+
+static void lfstktst2()
+{
+    struct LfTestContext * context;
+    pthread_t threads[LF_THREADS_COUNT];
+    size_t missed = 0;
+    size_t i;
+
+    UT_BEGIN("lock-free stack w/concurrent push and pop");
+
+    context = xmalloc(sizeof(struct LfTestContext));
+    memset(context->popped, 0, sizeof(context->popped));
+    context->index = 0;
+    context->errors = 0;
+    pthread_mutex_init(&context->lock, NULL);
+    lfi_lf_stack_init(&context->stack);
+
+    for (i = 0; i < LF_THREADS_COUNT; ++i)
+    {
+        UT_VERIFY_CRITICAL(0 == pthread_create(&threads[i], NULL, &lf_thread_proc, context));
+    }
+
+    for (i = 0; i < LF_THREADS_COUNT; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (i = 0; i < LF_THREADS_COUNT * LF_ELEMENTS_COUNT; ++i)
+    {
+        missed += (1 != context->popped[i]);
+    }
+
+    UT_VERIFY((context->errors == 0) && (missed == 0));
+    UT_VERIFY(lfi_lf_stack_empty(&context->stack));
+
+    lfi_lf_stack_uninit(&context->stack);
+    pthread_mutex_destroy(&context->lock);
+    xfree(context);
+    UT_END();
+}
+
+/*
+ * function that launches tests
+ */
+void test_lf_stack()
+{
+    lfstktst1();
+    lfstktst2();
+}
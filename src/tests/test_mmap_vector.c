@@ -0,0 +1,157 @@
+/* makes mremap available */
+#define _GNU_SOURCE
+
+#include <utilities/ut/ut.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * test vector stored in the file
+ */
+struct MmapTestRecord
+{
+    int     id;
+    double  value;
+    char    name[20];
+};
+
+#define MMAP_VECTOR_NS(name)        mrec_##name
+#define MMAP_VECTOR_ELEMENT_TYPE    struct MmapTestRecord
+#define MMAP_VECTOR_GROW_SIZE       (16)
+#define MMAP_VECTOR_CLEAR_REQUIRED
+#include <templates/mmap_vector.h>
+
+#define MMAP_VECTOR_NS(name)        mint_##name
+#define MMAP_VECTOR_ELEMENT_TYPE    int
+#include <templates/mmap_vector.h>
+
+static void init_mmap_test_record(struct MmapTestRecord * record, int id)
+{
+    record->id = id;
+    record->value = id * 0.5;
+    sprintf(record->name, "record %d", id);
+}
+
+static bool is_mmap_test_record(const struct MmapTestRecord * record, int id)
+{
+    struct MmapTestRecord expected;
+    init_mmap_test_record(&expected, id);
+    return (record->id == expected.id) && (record->value == expected.value) && (0 == strcmp(record->name, expected.name));
+}
+
+static void mmap_vector_test1(const char * path)
+{
+    mrec_mmap_vector vector;
+    struct MmapTestRecord records[100];
+    struct MmapTestRecord * record;
+    int i;
+
+    UT_BEGIN("mmap vector: reopen");
+
+    UT_VERIFY_CRITICAL(mrec_mmap_vector_open(&vector, path));
+    UT_VERIFY(mrec_mmap_vector_size(&vector) == 0);
+
+    for (i = 0; i < 1000; ++i)
+    {
+        struct MmapTestRecord r;
+        init_mmap_test_record(&r, i);
+        UT_VERIFY_SILENT(mrec_mmap_vector_push_back(&vector, r));
+    }
+
+    record = mrec_mmap_vector_emplace_back(&vector);
+    UT_VERIFY_CRITICAL(NULL != record);
+    init_mmap_test_record(record, 1000);
+
+    UT_VERIFY(mrec_mmap_vector_sync(&vector));
+    mrec_mmap_vector_close(&vector);
+
+    /* the elements are available after reopening */
+    UT_VERIFY_CRITICAL(mrec_mmap_vector_open(&vector, path));
+    UT_VERIFY(mrec_mmap_vector_size(&vector) == 1001);
+
+    for (i = 0; i < 1001; ++i)
+    {
+        UT_VERIFY_SILENT(is_mmap_test_record(mrec_mmap_vector_data(&vector) + i, i));
+    }
+
+    for (i = 0; i < 100; ++i)
+    {
+        init_mmap_test_record(&records[i], 1001 + i);
+    }
+
+    UT_VERIFY(mrec_mmap_vector_append_n(&vector, records, 100));
+    UT_VERIFY(mrec_mmap_vector_reserve(&vector, 5000));
+    UT_VERIFY(mrec_mmap_vector_size(&vector) == 1101);
+    mrec_mmap_vector_close(&vector);
+
+    /* changes are kept without explicit sync */
+    UT_VERIFY_CRITICAL(mrec_mmap_vector_open(&vector, path));
+    UT_VERIFY(mrec_mmap_vector_size(&vector) == 1101);
+    UT_VERIFY(vector.allocated >= 5000);
+
+    for (i = 0; i < 1101; ++i)
+    {
+        UT_VERIFY_SILENT(is_mmap_test_record(mrec_mmap_vector_data(&vector) + i, i));
+    }
+
+    mrec_mmap_vector_clear(&vector);
+    UT_VERIFY(mrec_mmap_vector_size(&vector) == 0);
+    mrec_mmap_vector_close(&vector);
+
+    UT_VERIFY_CRITICAL(mrec_mmap_vector_open(&vector, path));
+    UT_VERIFY(mrec_mmap_vector_size(&vector) == 0);
+    mrec_mmap_vector_close(&vector);
+
+    UT_END();
+}
+
+static void mmap_vector_test2(const char * path)
+{
+    mrec_mmap_vector vector;
+    mint_mmap_vector int_vector;
+    FILE * f;
+
+    UT_BEGIN("mmap vector: incompatible files");
+
+    UT_VERIFY_CRITICAL(mrec_mmap_vector_open(&vector, path));
+    mrec_mmap_vector_close(&vector);
+
+    /* element size mismatch */
+    UT_VERIFY(!mint_mmap_vector_open(&int_vector, path) && (EINVAL == errno));
+
+    /* not a vector's file */
+    f = fopen(path, "wb");
+    UT_VERIFY_CRITICAL(NULL != f);
+    fprintf(f, "%0256d", 0);
+    fclose(f);
+    UT_VERIFY(!mint_mmap_vector_open(&int_vector, path) && (EINVAL == errno));
+
+    UT_VERIFY(!mint_mmap_vector_open(&int_vector, "/nonexistent/vector.dat") && (ENOENT == errno));
+
+    UT_END();
+}
+
+/*
+ * function that launches tests
+ */
+void test_mmap_vector()
+{
+    char path[] = "/tmp/ctemplates_mmap_vector_XXXXXX";
+    int fd = mkstemp(path);
+
+    if (fd < 0)
+    {
+        fprintf(stderr, "mmap vector: can not create temporary file\n");
+        return;
+    }
+
+    close(fd);
+
+    mmap_vector_test1(path);
+
+    unlink(path);
+    mmap_vector_test2(path);
+
+    unlink(path);
+}
@@ -0,0 +1,232 @@
+#include <utilities/ut/ut.h>
+#include <utilities/alloc.h>
+
+#include <pthread.h>
+
+/*
+ * test fixed allocator shared between threads
+ */
+
+#define MT_FIXED_ALLOC_NS(n)            mti_##n
+#define MT_FIXED_ALLOC_ELEMENT_TYPE     size_t
+#define MT_FIXED_ALLOC_XMALLOC          xmalloc
+#define MT_FIXED_ALLOC_XFREE            xfree
+#define MT_FIXED_ALLOC_INITIAL_CHUNK_SIZE (2)
+#define MT_FIXED_ALLOC_MAGAZINE_SIZE    (8)
+#define MT_FIXED_ALLOC_DEPOT_SIZE       (2)
+#define MT_FIXED_ALLOC_GET_ALLOCATOR_STATUS_REQUIRED
+
+#include <templates/mt_fixed_alloc.h>
+
+static void mtfxtst1()
+{
+    mti_allocator allocator;
+    mti_cache c1;
+    mti_cache c2;
+    size_t * pp[100];
+    size_t used;
+    size_t allocated;
+    size_t i;
+
+    UT_BEGIN("mt fixed alloc w/two caches");
+    mti_init_allocator(&allocator);
+    mti_init_cache(&allocator, &c1);
+    mti_init_cache(&allocator, &c2);
+
+    for (i = 0; i < 100; ++i)
+    {
+        pp[i] = mti_alloc_elem(&c1);
+        *pp[i] = i;
+    }
+
+    /* whole magazines are taken from the pool */
+    mti_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 104) && (allocated >= used));
+
+    for (i = 0; i < 100; ++i)
+    {
+        UT_VERIFY_SILENT(*pp[i] == i);
+    }
+
+    /* elements freed by the other cache go to depot as full magazines */
+    for (i = 0; i < 40; ++i)
+    {
+        mti_free_elem(&c2, pp[i]);
+    }
+
+    UT_VERIFY(allocator.full_count == 2);
+
+    /* elements beyond the depot size are returned to the pool */
+    for (i = 40; i < 100; ++i)
+    {
+        mti_free_elem(&c2, pp[i]);
+    }
+
+    UT_VERIFY(allocator.full_count == 2);
+
+    mti_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY(used == c1.loaded->count + c2.loaded->count + c2.previous->count);
+
+    /* the first cache is reloaded from depot */
+    for (i = 0; i < 28; ++i)
+    {
+        pp[i] = mti_alloc_elem(&c1);
+    }
+
+    UT_VERIFY(allocator.full_count == 0);
+
+    for (i = 0; i < 28; ++i)
+    {
+        mti_free_elem(&c1, pp[i]);
+    }
+
+    mti_uninit_cache(&c2);
+    mti_uninit_cache(&c1);
+
+    /* elements held by depot are not counted as used ones */
+    mti_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocator.full_count == 2));
+
+    mti_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * each thread allocates the elements and frees the ones allocated by its neighbour
+ */
+
+#define MT_THREADS_COUNT    (4)
+#define MT_ELEMENTS_COUNT   (1000)
+#define MT_ROUNDS_COUNT     (50)
+
+struct MtTestContext
+{
+    mti_allocator * allocator;
+    size_t *        pp[MT_THREADS_COUNT][MT_ELEMENTS_COUNT];
+    size_t          index;
+    size_t          errors;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    size_t          arrived;
+    size_t          generation;
+};
+
+static void mt_barrier(struct MtTestContext * context)
+{
+    size_t generation;
+
+    pthread_mutex_lock(&context->lock);
+    generation = context->generation;
+    if (++context->arrived == MT_THREADS_COUNT)
+    {
+        context->arrived = 0;
+        ++context->generation;
+        pthread_cond_broadcast(&context->cond);
+    }
+    else
+    {
+        while (generation == context->generation)
+        {
+            pthread_cond_wait(&context->cond, &context->lock);
+        }
+    }
+    pthread_mutex_unlock(&context->lock);
+}
+
+static void * mt_thread_proc(void * p)
+{
+    struct MtTestContext * context = p;
+    mti_cache cache;
+    size_t index;
+    size_t neighbour;
+    size_t errors = 0;
+    size_t r;
+    size_t i;
+
+    pthread_mutex_lock(&context->lock);
+    index = context->index++;
+    pthread_mutex_unlock(&context->lock);
+    neighbour = (index + 1) % MT_THREADS_COUNT;
+
+    mti_init_cache(context->allocator, &cache);
+
+    for (r = 0; r < MT_ROUNDS_COUNT; ++r)
+    {
+        for (i = 0; i < MT_ELEMENTS_COUNT; ++i)
+        {
+            size_t * e = mti_alloc_elem(&cache);
+            *e = (index * MT_ROUNDS_COUNT + r) * MT_ELEMENTS_COUNT + i;
+            context->pp[index][i] = e;
+        }
+
+        mt_barrier(context);
+
+        for (i = 0; i < MT_ELEMENTS_COUNT; ++i)
+        {
+            size_t * e = context->pp[neighbour][i];
+            errors += (*e != (neighbour * MT_ROUNDS_COUNT + r) * MT_ELEMENTS_COUNT + i);
+            mti_free_elem(&cache, e);
+        }
+
+        mt_barrier(context);
+    }
+
+    mti_uninit_cache(&cache);
+
+    pthread_mutex_lock(&context->lock);
+    context->errors += errors;
+    pthread_mutex_unlock(&context->lock);
+    return NULL;
+}
+
+static void mtfxtst2()
+{
+    mti_allocator allocator;
+    struct MtTestContext * context;
+    pthread_t threads[MT_THREADS_COUNT];
+    size_t used;
+    size_t allocated;
+    size_t i;
+
+    UT_BEGIN("mt fixed alloc w/cross-thread frees");
+    mti_init_allocator(&allocator);
+
+    context = xmalloc(sizeof(struct MtTestContext));
+    context->allocator = &allocator;
+    context->index = 0;
+    context->errors = 0;
+    context->arrived = 0;
+    context->generation = 0;
+    pthread_mutex_init(&context->lock, NULL);
+    pthread_cond_init(&context->cond, NULL);
+
+    for (i = 0; i < MT_THREADS_COUNT; ++i)
+    {
+        UT_VERIFY_CRITICAL(0 == pthread_create(&threads[i], NULL, &mt_thread_proc, context));
+    }
+
+    for (i = 0; i < MT_THREADS_COUNT; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    UT_VERIFY(context->errors == 0);
+
+    mti_get_allocator_status(&allocator, &used, &allocated);
+    UT_VERIFY((used == 0) && (allocated >= MT_THREADS_COUNT * MT_ELEMENTS_COUNT));
+
+    pthread_cond_destroy(&context->cond);
+    pthread_mutex_destroy(&context->lock);
+    xfree(context);
+    mti_uninit_allocator(&allocator);
+    UT_END();
+}
+
+/*
+ * function that launches tests
+ */
+void test_mt_fixed_alloc()
+{
+    mtfxtst1();
+    mtfxtst2();
+}
@@ -64,6 +64,9 @@ static void test_simple_rb_tree()
     fprintf(stream, "%d(%s)", node->key, (node->color == RB_TREE_RED ? "R" : "B"))
 
 #define RB_TREE_FOREACH_REQUIRED
+#define RB_TREE_ITERATION_REQUIRED
+#define RB_TREE_CLEAR_REQUIRED
+#define RB_TREE_COUNT_REQUIRED
 
 #include <templates/rb_tree.h>
 
@@ -108,6 +111,133 @@ static void test_int_rb_tree2()
     UT_END();
 }
 
+static void test_int_rb_tree3()
+{
+    int_tree tree;
+    const size_t total = 500;
+    const void * cluster = NULL;
+    size_t r;
+    size_t i;
+    int * arr = xmalloc(sizeof(int) * total);
+
+    UT_BEGIN("rb tree clear");
+
+    ut_init_ascending_naturals(arr, total);
+    int_init_tree(&tree);
+
+    for (r = 0; r < 3; ++r)
+    {
+        ut_permutate(arr, total, 2);
+
+        for (i = 0; i < total; ++i)
+        {
+            int_node * n = int_add_node(&tree, arr[i]);
+            UT_VERIFY_SILENT((n != NULL) && (n->key == arr[i]));
+        }
+
+        UT_VERIFY((tree.count == total) && int_is_valid_tree(&tree));
+
+        /* remove some of the nodes to leave the sentinel dirty */
+        for (i = 0; i < total; i += 7)
+        {
+            UT_VERIFY_SILENT(int_remove_node(&tree, arr[i]));
+        }
+
+        UT_VERIFY(int_is_valid_tree(&tree));
+
+        /* memory is reused on the subsequent rounds */
+        if (r == 0)
+        {
+            cluster = tree.allocator.cluster;
+        }
+        else
+        {
+            UT_VERIFY(tree.allocator.cluster == cluster);
+        }
+
+        int_tree_clear(&tree);
+        UT_VERIFY((tree.count == 0) && int_is_valid_tree(&tree));
+
+        for (i = 0; i < total; ++i)
+        {
+            UT_VERIFY_SILENT(int_find_node(&tree, arr[i]) == NULL);
+        }
+    }
+
+    int_uninit_tree(&tree);
+    xfree(arr);
+    UT_END();
+}
+
+static void test_int_rb_tree4()
+{
+    int_tree tree;
+    const size_t total = 500;
+    int_node * node;
+    size_t count;
+    size_t i;
+    int prev_key;
+    int * arr = xmalloc(sizeof(int) * total);
+
+    UT_BEGIN("rb tree iteration");
+
+    int_init_tree(&tree);
+    UT_VERIFY((int_tree_first(&tree) == NULL) && (int_tree_last(&tree) == NULL));
+
+    ut_init_ascending_naturals(arr, total);
+    ut_permutate(arr, total, 2);
+
+    for (i = 0; i < total; ++i)
+    {
+        int_add_node(&tree, arr[i]);
+    }
+
+    for (i = 0; i < total; i += 3)
+    {
+        int_remove_node(&tree, arr[i]);
+    }
+
+    UT_VERIFY(int_is_valid_tree(&tree));
+
+    /* ascending order */
+    count = 0;
+    prev_key = -1;
+    for (node = int_tree_first(&tree); node != NULL; node = int_node_next(&tree, node))
+    {
+        UT_VERIFY_SILENT(node->key > prev_key);
+        prev_key = node->key;
+        ++count;
+    }
+
+    UT_VERIFY((count == tree.count) && (prev_key == int_tree_last(&tree)->key));
+
+    /* descending order */
+    count = 0;
+    prev_key = (int)total;
+    for (node = int_tree_last(&tree); node != NULL; node = int_node_prev(&tree, node))
+    {
+        UT_VERIFY_SILENT(node->key < prev_key);
+        prev_key = node->key;
+        ++count;
+    }
+
+    UT_VERIFY((count == tree.count) && (prev_key == int_tree_first(&tree)->key));
+
+    /* the traversal may be turned back at any node */
+    node = int_node_next(&tree, int_tree_first(&tree));
+    UT_VERIFY(int_node_prev(&tree, int_node_next(&tree, node)) == node);
+
+    /* single node */
+    int_tree_clear(&tree);
+    node = int_add_node(&tree, 42);
+    UT_VERIFY((int_tree_first(&tree) == node) && (int_tree_last(&tree) == node));
+    UT_VERIFY((int_node_next(&tree, node) == NULL) && (int_node_prev(&tree, node) == NULL));
+
+    int_uninit_tree(&tree);
+    xfree(arr);
+    UT_END();
+}
+
 /*
  * tree of double numbers
  */
@@ -120,6 +250,8 @@ static void test_int_rb_tree2()
 #define RB_TREE_XMALLOC              xmalloc
 #define RB_TREE_XFREE                xfree
 #define RB_TREE_IS_VALID_TREE_REQUIRED
+#define RB_TREE_INITIAL_CHUNK_SIZE   (2)
+#define RB_TREE_RELEASE_EMPTY_CLUSTERS
 
 #include <templates/rb_tree.h>
 
@@ -156,6 +288,9 @@ static void test_dbl_rb_tree1()
 
     /* remove all the nodes away */
 
+    /* all the clusters except for the retained one shall be released */
+    UT_VERIFY((tree.allocator.cluster != NULL) && (tree.allocator.cluster->prev == NULL));
+
     dbl_uninit_tree(&tree);
     UT_END();
 }
@@ -251,6 +386,8 @@ void test_rb_tree()
     test_simple_rb_tree();
     test_int_rb_tree1();
     test_int_rb_tree2();
+    test_int_rb_tree3();
+    test_int_rb_tree4();
     test_dbl_rb_tree1();
     test_intv_rb_tree1();
     test_intv_rb_tree2();
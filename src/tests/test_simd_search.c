@@ -0,0 +1,134 @@
+#include <utilities/ut/ut.h>
+#include <utilities/alloc.h>
+
+#include <stdint.h>
+
+
+#define SIMD_SEARCH_NS(name)    chr_##name
+#define SIMD_SEARCH_KEY_TYPE    char
+#include <templates/simd_search.h>
+
+#define SIMD_SEARCH_NS(name)    u8_##name
+#define SIMD_SEARCH_KEY_TYPE    uint8_t
+#include <templates/simd_search.h>
+
+#define SIMD_SEARCH_NS(name)    i16_##name
+#define SIMD_SEARCH_KEY_TYPE    int16_t
+#include <templates/simd_search.h>
+
+#define SIMD_SEARCH_NS(name)    u32_##name
+#define SIMD_SEARCH_KEY_TYPE    uint32_t
+#include <templates/simd_search.h>
+
+#define SIMD_SEARCH_NS(name)    i64_##name
+#define SIMD_SEARCH_KEY_TYPE    int64_t
+#include <templates/simd_search.h>
+
+#define SIMD_SEARCH_NS(name)    dbl_##name
+#define SIMD_SEARCH_KEY_TYPE    double
+#include <templates/simd_search.h>
+
+static void simd_search_test1()
+{
+    const char chars[] = "acegikmoqsuwy";
+    const size_t count = sizeof(chars) - 1;
+
+    UT_BEGIN("simd search test #1");
+
+    // positive tests
+    UT_VERIFY(0 == chr_simd_binary_search(chars, count, 'a'));
+    UT_VERIFY(6 == chr_simd_binary_search(chars, count, 'm'));
+    UT_VERIFY(12 == chr_simd_binary_search(chars, count, 'y'));
+
+    // negative tests
+    UT_VERIFY(0 == ~chr_simd_binary_search(chars, count, ' '));
+    UT_VERIFY(7 == ~chr_simd_binary_search(chars, count, 'n'));
+    UT_VERIFY(13 == ~chr_simd_binary_search(chars, count, 'z'));
+    UT_VERIFY(0 == ~chr_simd_binary_search(chars, 0, 'a'));
+
+    UT_END();
+}
+
+/*
+ * compares the search results to the linear search over the arrays of all sizes up to the given one,
+ * the elements are spread over the whole range of the type, so the unsigned and negative values are met
+ */
+#define TEST_SIMD_SEARCH(ns, type, max_count, first_value, step) \
+    { \
+        type arr[max_count]; \
+        size_t count; \
+        size_t i; \
+        for (i = 0; i < max_count; ++i) \
+        { \
+            arr[i] = (type)(first_value + (type)(i / 2) * step); \
+        } \
+        for (count = 0; count <= max_count; ++count) \
+        { \
+            for (i = 0; i < count + 1; ++i) \
+            { \
+                type key = (i < count) ? arr[i] : (type)(arr[max_count - 1] + 1); \
+                type less_key = (type)(key - 1); \
+                size_t lower = 0; \
+                size_t less_lower = 0; \
+                while ((lower < count) && (arr[lower] < key)) ++lower; \
+                while ((less_lower < count) && (arr[less_lower] < less_key)) ++less_lower; \
+                UT_VERIFY_SILENT(lower == ns##simd_lower_bound(arr, count, key)); \
+                UT_VERIFY_SILENT(less_lower == ns##simd_lower_bound(arr, count, less_key)); \
+                UT_VERIFY_SILENT(((lower < count) && (arr[lower] == key) ? (ptrdiff_t)lower : ~(ptrdiff_t)lower) == \
+                                 ns##simd_binary_search(arr, count, key)); \
+            } \
+        } \
+    }
+
+static void simd_search_test2()
+{
+    UT_BEGIN("simd search test #2: arrays of various sizes");
+
+    TEST_SIMD_SEARCH(chr_, char, 120, -120, 3);
+    TEST_SIMD_SEARCH(u8_, uint8_t, 120, 10, 3);
+    TEST_SIMD_SEARCH(i16_, int16_t, 200, -30000, 500);
+    TEST_SIMD_SEARCH(u32_, uint32_t, 200, 10, 40000000);
+    TEST_SIMD_SEARCH(i64_, int64_t, 100, -4000000000000000000LL, 80000000000000000LL);
+    TEST_SIMD_SEARCH(dbl_, double, 100, -1000.5, 20.25);
+
+    UT_END();
+}
+
+static void simd_search_test3()
+{
+    char arr[5000];
+    size_t i;
+    int key;
+
+    UT_BEGIN("simd search test #3: large array with the runs of equal keys");
+
+    // many full vectors are compared before the overlapping last one
+    for (i = 0; i < sizeof(arr); ++i)
+    {
+        arr[i] = (char)((int)(i * 100 / sizeof(arr)) - 50);
+    }
+
+    for (key = -51; key <= 51; ++key)
+    {
+        size_t lower = 0;
+
+        while ((lower < sizeof(arr)) && (arr[lower] < key))
+        {
+            ++lower;
+        }
+
+        UT_VERIFY_SILENT(lower == chr_simd_lower_bound(arr, sizeof(arr), (char)key));
+    }
+
+    UT_END();
+}
+
+/*
+ * function that launches tests
+ */
+void test_simd_search()
+{
+    simd_search_test1();
+    simd_search_test2();
+    simd_search_test3();
+}
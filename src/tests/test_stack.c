@@ -90,43 +90,205 @@ static void stktst3()
     UT_BEGIN("stack 3: with preallocated elements");
 
     dbl_stack_init(&stack);
-    UT_VERIFY(dbl_stack_empty(&stack) && (stack.size == 0) && (stack.allocated == 0));
+    UT_VERIFY(dbl_stack_empty(&stack) && (stack.size == 0) && (stack.allocated == 2));
+    UT_VERIFY(stack.elements == stack.prealloc_elements);
 
     dbl_stack_push(&stack, 1.0);
-    UT_VERIFY(!dbl_stack_empty(&stack) && (stack.size == 1) && (stack.allocated == 0));
+    UT_VERIFY(!dbl_stack_empty(&stack) && (stack.size == 1) && (stack.allocated == 2));
     dbl_stack_push(&stack, 2.0);
-    UT_VERIFY((stack.size == 2) && (stack.allocated == 0));
+    UT_VERIFY((stack.size == 2) && (stack.allocated == 2) && (dbl_stack_top(&stack) == 2.0));
     
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 2.0) && (stack.size == 1) && (stack.allocated == 0));
+    UT_VERIFY((n == 2.0) && (stack.size == 1) && (stack.allocated == 2));
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 1.0) && (stack.size == 0) && (stack.allocated == 0));
+    UT_VERIFY((n == 1.0) && (stack.size == 0) && (stack.allocated == 2));
 
     dbl_stack_push(&stack, 1.0);
     dbl_stack_push(&stack, 2.0);
-    UT_VERIFY((stack.size == 2) && (stack.allocated == 0));
+    UT_VERIFY((stack.size == 2) && (stack.elements == stack.prealloc_elements));
     dbl_stack_push(&stack, 3.0);
-    UT_VERIFY((stack.size == 3) && (stack.allocated == 2));
+    UT_VERIFY((stack.size == 3) && (stack.allocated == 4) && (stack.elements != stack.prealloc_elements));
     dbl_stack_push(&stack, 4.0);
-    UT_VERIFY((stack.size == 4) && (stack.allocated == 2));
+    UT_VERIFY((stack.size == 4) && (stack.allocated == 4));
     dbl_stack_push(&stack, 5.0);
-    UT_VERIFY((stack.size == 5) && (stack.allocated == 4));
+    UT_VERIFY((stack.size == 5) && (stack.allocated == 6));
 
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 5.0) && (stack.size == 4) && (stack.allocated == 4));
+    UT_VERIFY((n == 5.0) && (stack.size == 4) && (stack.allocated == 6));
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 4.0) && (stack.size == 3) && (stack.allocated == 4));
+    UT_VERIFY((n == 4.0) && (stack.size == 3) && (stack.allocated == 6));
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 3.0) && (stack.size == 2) && (stack.allocated == 4));
+    UT_VERIFY((n == 3.0) && (stack.size == 2) && (stack.allocated == 6));
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 2.0) && (stack.size == 1) && (stack.allocated == 4));
+    UT_VERIFY((n == 2.0) && (stack.size == 1) && (stack.allocated == 6));
     n = dbl_stack_pop(&stack);
-    UT_VERIFY((n == 1.0) && (stack.size == 0) && (stack.allocated == 4));
+    UT_VERIFY((n == 1.0) && (stack.size == 0) && (stack.allocated == 6));
 
     dbl_stack_uninit(&stack);
     UT_END();
 }
 
+/*
+ * test stack with multiplicative growth
+ */
+#define STACK_NS(name)       gf_##name
+#define STACK_ELEMENT_TYPE   int
+#define STACK_XREALLOC       xrealloc
+#define STACK_XFREE          xfree
+#define STACK_PREALLOCATED_SIZE (4)
+#define STACK_GROW_SIZE      (8)
+#define STACK_GROW_FACTOR    2
+
+#include <templates/stack.h>
+
+static void stktst4()
+{
+    gf_stack stack;
+    int elements[100];
+    size_t reallocations = 0;
+    size_t allocated;
+    int i;
+    UT_BEGIN("stack 4: with grow factor and bulk operations");
+
+    gf_stack_init(&stack);
+    allocated = stack.allocated;
+
+    for (i = 0; i < 10000; ++i)
+    {
+        gf_stack_push(&stack, i);
+        if (stack.allocated != allocated)
+        {
+            UT_VERIFY_SILENT(stack.allocated == ((allocated < 8) ? 8 : 2 * allocated));
+            allocated = stack.allocated;
+            ++reallocations;
+        }
+    }
+
+    UT_VERIFY((reallocations < 15) && (gf_stack_top(&stack) == 9999));
+
+    for (i = 9999; i >= 0; --i)
+    {
+        UT_VERIFY_SILENT(gf_stack_pop(&stack) == i);
+    }
+
+    UT_VERIFY(gf_stack_empty(&stack));
+    gf_stack_uninit(&stack);
+
+    /* bulk operations */
+    gf_stack_init(&stack);
+
+    for (i = 0; i < 100; ++i)
+    {
+        elements[i] = i;
+    }
+
+    gf_stack_push_n(&stack, elements, 3);
+    UT_VERIFY((stack.elements == stack.prealloc_elements) && (gf_stack_top(&stack) == 2));
+
+    gf_stack_push_n(&stack, elements + 3, 97);
+    UT_VERIFY((stack.size == 100) && (stack.allocated == 100) && (gf_stack_top(&stack) == 99));
+
+    gf_stack_reserve(&stack, 1000);
+    UT_VERIFY(stack.allocated == 1000);
+    gf_stack_reserve(&stack, 10);
+    UT_VERIFY(stack.allocated == 1000);
+
+    gf_stack_pop_n(&stack, elements, 10);
+    UT_VERIFY((stack.size == 90) && (elements[0] == 90) && (elements[9] == 99) && (gf_stack_top(&stack) == 89));
+
+    gf_stack_pop_n(&stack, NULL, 89);
+    UT_VERIFY((stack.size == 1) && (gf_stack_pop(&stack) == 0) && gf_stack_empty(&stack));
+
+    gf_stack_uninit(&stack);
+    UT_END();
+}
+
+/*
+ * test segmented stack
+ */
+static size_t g_segment_allocations = 0;
+
+static void * counting_xmalloc(size_t size)
+{
+    ++g_segment_allocations;
+    return xmalloc(size);
+}
+
+#define SEGMENTED_STACK_NS(name)       seg_##name
+#define SEGMENTED_STACK_ELEMENT_TYPE   int
+#define SEGMENTED_STACK_XMALLOC        counting_xmalloc
+#define SEGMENTED_STACK_XFREE          xfree
+#define SEGMENTED_STACK_SEGMENT_SIZE   (4)
+
+#include <templates/segmented_stack.h>
+
+static void stktst5()
+{
+    seg_segmented_stack stack;
+    int * addresses[100];
+    int i;
+    UT_BEGIN("stack 5: segmented stack");
+
+    seg_segmented_stack_init(&stack);
+    UT_VERIFY(seg_segmented_stack_empty(&stack) && (g_segment_allocations == 0));
+
+    for (i = 0; i < 100; ++i)
+    {
+        addresses[i] = seg_segmented_stack_push(&stack, i);
+    }
+
+    UT_VERIFY((seg_segmented_stack_size(&stack) == 100) && (g_segment_allocations == 25));
+    UT_VERIFY((*seg_segmented_stack_top(&stack) == 99) && (seg_segmented_stack_top(&stack) == addresses[99]));
+
+    /* elements are never moved */
+    for (i = 0; i < 100; ++i)
+    {
+        UT_VERIFY_SILENT(*addresses[i] == i);
+    }
+
+    /* pushing and popping at the segment's boundary reuses the cached segment */
+    for (i = 0; i < 10; ++i)
+    {
+        seg_segmented_stack_push(&stack, 100);
+        UT_VERIFY_SILENT(seg_segmented_stack_pop(&stack) == 100);
+    }
+
+    UT_VERIFY((seg_segmented_stack_size(&stack) == 100) && (g_segment_allocations == 26));
+
+    for (i = 99; i >= 50; --i)
+    {
+        UT_VERIFY_SILENT(seg_segmented_stack_pop(&stack) == i);
+    }
+
+    UT_VERIFY(*seg_segmented_stack_top(&stack) == 49);
+
+    /* the top segment is filled up, then the last released one is reused */
+    for (i = 50; i < 56; ++i)
+    {
+        UT_VERIFY_SILENT(seg_segmented_stack_push(&stack, i) == addresses[i]);
+    }
+
+    UT_VERIFY(g_segment_allocations == 26);
+
+    for (i = 56; i < 60; ++i)
+    {
+        seg_segmented_stack_push(&stack, i);
+    }
+
+    for (i = 59; i >= 0; --i)
+    {
+        UT_VERIFY_SILENT(seg_segmented_stack_pop(&stack) == i);
+    }
+
+    UT_VERIFY(seg_segmented_stack_empty(&stack) && (g_segment_allocations == 27));
+
+    seg_segmented_stack_push(&stack, 1);
+    UT_VERIFY((*seg_segmented_stack_top(&stack) == 1) && (g_segment_allocations == 27));
+
+    seg_segmented_stack_uninit(&stack);
+    UT_END();
+}
+
 /*
  * test pack
  */
@@ -135,4 +297,6 @@ void test_stack()
     stktst1();
     stktst2();
     stktst3();
+    stktst4();
+    stktst5();
 }
@@ -54,6 +54,303 @@ static void test_double_vector()
     UT_END();
 }
 
+static void test_double_vector_reserve()
+{
+    dbl_vector vector;
+    size_t i;
+    UT_BEGIN("vector: reserve and shrink preallocated doubles");
+
+    dbl_vector_init(&vector);
+
+    /* preallocated array is enough */
+    dbl_vector_reserve(&vector, 2);
+    UT_VERIFY((vector.elements == vector.prealloc_elements) && (vector.allocated == 2));
+
+    dbl_vector_reserve(&vector, 100);
+    UT_VERIFY((vector.elements != vector.prealloc_elements) && (vector.allocated == 100));
+
+    for (i = 0; i < 100; ++i)
+    {
+        dbl_vector_push_back(&vector, (double)i);
+    }
+
+    UT_VERIFY(vector.allocated == 100);
+
+    dbl_vector_push_back(&vector, 100.0);
+    UT_VERIFY(vector.allocated == 102);
+
+    dbl_vector_shrink_to_fit(&vector);
+    UT_VERIFY(vector.allocated == 101);
+
+    for (i = 0; i < 101; ++i)
+    {
+        UT_VERIFY_SILENT(dbl_vector_data(&vector)[i] == (double)i);
+    }
+
+    /* elements are moved back to the preallocated array */
+    vector.size = 1;
+    dbl_vector_shrink_to_fit(&vector);
+    UT_VERIFY((vector.elements == vector.prealloc_elements) && (vector.allocated == 2));
+    UT_VERIFY((dbl_vector_size(&vector) == 1) && (dbl_vector_data(&vector)[0] == 0.0));
+
+    dbl_vector_push_back(&vector, 1.0);
+    dbl_vector_push_back(&vector, 2.0);
+    UT_VERIFY((vector.elements != vector.prealloc_elements) && (dbl_vector_size(&vector) == 3));
+    UT_VERIFY((dbl_vector_data(&vector)[0] == 0.0) && (dbl_vector_data(&vector)[2] == 2.0));
+
+    dbl_vector_uninit(&vector);
+    UT_END();
+}
+
+/*
+ * test vector with multiplicative growth
+ */
+#define VECTOR_NS(name)       gf_##name
+#define VECTOR_ELEMENT_TYPE   int
+#define VECTOR_XREALLOC       xrealloc
+#define VECTOR_XFREE          xfree
+#define VECTOR_GROW_SIZE      (4)
+#define VECTOR_GROW_FACTOR    1.5
+#include <templates/vector.h>
+
+static void test_grow_factor_vector()
+{
+    gf_vector vector;
+    size_t reallocations = 0;
+    size_t allocated = 0;
+    int i;
+    UT_BEGIN("vector: with grow factor");
+
+    gf_vector_init(&vector);
+
+    for (i = 0; i < 10000; ++i)
+    {
+        gf_vector_push_back(&vector, i);
+        if (vector.allocated != allocated)
+        {
+            UT_VERIFY_SILENT((allocated == 0) ? (vector.allocated == 4) : (vector.allocated == allocated * 3 / 2));
+            allocated = vector.allocated;
+            ++reallocations;
+        }
+    }
+
+    /* count of reallocations grows logarithmically */
+    UT_VERIFY(reallocations < 25);
+
+    for (i = 0; i < 10000; ++i)
+    {
+        UT_VERIFY_SILENT(gf_vector_data(&vector)[i] == i);
+    }
+
+    gf_vector_shrink_to_fit(&vector);
+    UT_VERIFY((vector.allocated == 10000) && (gf_vector_data(&vector)[9999] == 9999));
+
+    vector.size = 0;
+    gf_vector_shrink_to_fit(&vector);
+    UT_VERIFY((NULL == vector.elements) && (vector.allocated == 0));
+
+    gf_vector_push_back(&vector, 42);
+    UT_VERIFY((vector.allocated == 4) && (gf_vector_data(&vector)[0] == 42));
+
+    gf_vector_uninit(&vector);
+    UT_END();
+}
+
+/*
+ * test vector of structures
+ */
+struct VecTestRecord
+{
+    int     id;
+    char    payload[60];
+};
+
+#define VECTOR_NS(name)       rec_##name
+#define VECTOR_ELEMENT_TYPE   struct VecTestRecord
+#define VECTOR_XREALLOC       xrealloc
+#define VECTOR_XFREE          xfree
+#define VECTOR_PREALLOCATED_SIZE (4)
+#define VECTOR_GROW_SIZE      (8)
+#define VECTOR_GROW_FACTOR    2
+#include <templates/vector.h>
+
+static void test_record_vector_bulk()
+{
+    rec_vector vector;
+    struct VecTestRecord records[50];
+    struct VecTestRecord * record;
+    size_t i;
+    UT_BEGIN("vector: bulk append and emplace of records");
+
+    rec_vector_init(&vector);
+
+    for (i = 0; i < 50; ++i)
+    {
+        records[i].id = (int)i;
+        records[i].payload[0] = (char)('a' + i % 26);
+    }
+
+    /* fits the preallocated array */
+    rec_vector_append_n(&vector, records, 3);
+    UT_VERIFY((vector.elements == vector.prealloc_elements) && (rec_vector_size(&vector) == 3));
+
+    record = rec_vector_emplace_back(&vector);
+    record->id = 3;
+    record->payload[0] = 'd';
+    UT_VERIFY((vector.elements == vector.prealloc_elements) && (rec_vector_size(&vector) == 4));
+
+    record = rec_vector_emplace_back(&vector);
+    record->id = 4;
+    record->payload[0] = 'e';
+    UT_VERIFY((vector.elements != vector.prealloc_elements) && (rec_vector_size(&vector) == 5));
+
+    rec_vector_append_n(&vector, records + 5, 45);
+    UT_VERIFY(rec_vector_size(&vector) == 50);
+
+    for (i = 0; i < 50; ++i)
+    {
+        record = rec_vector_data(&vector) + i;
+        UT_VERIFY_SILENT((record->id == (int)i) && (record->payload[0] == (char)('a' + i % 26)));
+    }
+
+    rec_vector_append_n(&vector, records, 0);
+    UT_VERIFY(rec_vector_size(&vector) == 50);
+
+    rec_vector_resize(&vector, 1000);
+    UT_VERIFY((rec_vector_size(&vector) == 1000) && (vector.allocated >= 1000));
+    UT_VERIFY(rec_vector_data(&vector)[49].id == 49);
+
+    rec_vector_resize(&vector, 2);
+    UT_VERIFY((rec_vector_size(&vector) == 2) && (rec_vector_data(&vector)[1].id == 1));
+
+    rec_vector_uninit(&vector);
+    UT_END();
+}
+
+/*
+ * test sorting of the vectors
+ */
+struct VecSortRecord
+{
+    int     key;
+    int     seq;
+};
+
+#define VEC_SORT_RECORD_COMPARE(left, right) (((left).key > (right).key) - ((left).key < (right).key))
+
+#define VECTOR_NS(name)       srt_##name
+#define VECTOR_ELEMENT_TYPE   struct VecSortRecord
+#define VECTOR_XREALLOC       xrealloc
+#define VECTOR_XFREE          xfree
+#define VECTOR_3W_COMPARE     VEC_SORT_RECORD_COMPARE
+#include <templates/vector.h>
+
+#define VECTOR_NS(name)       rdx_##name
+#define VECTOR_ELEMENT_TYPE   struct VecSortRecord
+#define VECTOR_XREALLOC       xrealloc
+#define VECTOR_XFREE          xfree
+#define VECTOR_3W_COMPARE     VEC_SORT_RECORD_COMPARE
+#define VECTOR_RADIX_KEY(element) ((unsigned int)(element).key ^ 0x80000000U)
+#include <templates/vector.h>
+
+#define VECTOR_NS(name)       par_##name
+#define VECTOR_ELEMENT_TYPE   struct VecSortRecord
+#define VECTOR_XREALLOC       xrealloc
+#define VECTOR_XFREE          xfree
+#define VECTOR_3W_COMPARE     VEC_SORT_RECORD_COMPARE
+#define VECTOR_SORT_THREADS   (3)
+#define VECTOR_SORT_PARALLEL_THRESHOLD (100)
+#include <templates/vector.h>
+
+/* fills the records with the pseudo-random keys, ranged so that duplicates and negative keys are present */
+static void fill_sort_records(struct VecSortRecord * records, size_t count, int range)
+{
+    unsigned int seed = 12345;
+    size_t i;
+
+    for (i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        records[i].key = (int)((seed >> 8) % (unsigned int)range) - range / 2;
+        records[i].seq = (int)i;
+    }
+}
+
+/* verifies that records are sorted and equal keys retain their original order */
+static bool is_stable_sorted(const struct VecSortRecord * records, size_t count)
+{
+    size_t i;
+
+    for (i = 1; i < count; ++i)
+    {
+        if ((records[i - 1].key > records[i].key) ||
+            ((records[i - 1].key == records[i].key) && (records[i - 1].seq > records[i].seq)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* returns sum of the records' sequence numbers to check that sorted records are a permutation */
+static size_t sort_records_checksum(const struct VecSortRecord * records, size_t count)
+{
+    size_t sum = 0;
+    size_t i;
+
+    for (i = 0; i < count; ++i)
+    {
+        sum += (size_t)records[i].seq * (size_t)(records[i].key + 1000000);
+    }
+
+    return sum;
+}
+
+#define TEST_SORT_VECTOR(prefix, count, range) \
+    { \
+        prefix##_vector vector; \
+        size_t checksum; \
+        size_t size; \
+        size_t k; \
+        prefix##_vector_init(&vector); \
+        prefix##_vector_resize(&vector, count); \
+        fill_sort_records(prefix##_vector_data(&vector), count, range); \
+        checksum = sort_records_checksum(prefix##_vector_data(&vector), count); \
+        prefix##_vector_sort(&vector); \
+        UT_VERIFY(is_stable_sorted(prefix##_vector_data(&vector), count)); \
+        UT_VERIFY(checksum == sort_records_checksum(prefix##_vector_data(&vector), count)); \
+        size = prefix##_vector_unique(&vector); \
+        UT_VERIFY(size == prefix##_vector_size(&vector)); \
+        UT_VERIFY(is_stable_sorted(prefix##_vector_data(&vector), size)); \
+        for (k = 1; k < size; ++k) \
+        { \
+            UT_VERIFY_SILENT(prefix##_vector_data(&vector)[k - 1].key < prefix##_vector_data(&vector)[k].key); \
+        } \
+        prefix##_vector_uninit(&vector); \
+    }
+
+static void test_sort_vector()
+{
+    UT_BEGIN("vector: sort and unique");
+
+    TEST_SORT_VECTOR(srt, 0, 10);
+    TEST_SORT_VECTOR(srt, 1, 10);
+    TEST_SORT_VECTOR(srt, 15, 10);
+    TEST_SORT_VECTOR(srt, 1000, 100);
+    TEST_SORT_VECTOR(srt, 10007, 1 << 30);
+
+    TEST_SORT_VECTOR(rdx, 100, 10);
+    TEST_SORT_VECTOR(rdx, 1000, 100);
+    TEST_SORT_VECTOR(rdx, 10007, 1 << 30);
+
+    TEST_SORT_VECTOR(par, 50, 10);
+    TEST_SORT_VECTOR(par, 101, 10);
+    TEST_SORT_VECTOR(par, 10007, 1000);
+
+    UT_END();
+}
+
 /*
  * test pack
  */
@@ -61,4 +358,8 @@ void test_vector()
 {
     test_char_vector();
     test_double_vector();
+    test_double_vector_reserve();
+    test_grow_factor_vector();
+    test_record_vector_bulk();
+    test_sort_vector();
 }
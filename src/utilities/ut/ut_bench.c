@@ -0,0 +1,31 @@
+#include "ut_bench.h"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+
+#include <time.h>
+
+double ut_bench_time()
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+#else
+
+#include <time.h>
+
+double ut_bench_time()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+#endif
+
+void ut_bench_report(const char * bench_name, size_t ops, double seconds)
+{
+    fprintf(stderr, "bench %-48s %10lu ops %9.3f ms %9.2f ns/op\n",
+        bench_name, (unsigned long)ops, seconds * 1e3, (ops > 0 ? seconds * 1e9 / ops : 0.0));
+}
@@ -0,0 +1,17 @@
+/*
+ * defines helpers for the performance measurements
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * returns current value of the monotonic clock in seconds
+ */
+double ut_bench_time();
+
+/*
+ * prints the time spent on the given count of operations
+ */
+void ut_bench_report(const char * bench_name, size_t ops, double seconds);